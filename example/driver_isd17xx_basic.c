@@ -57,7 +57,10 @@ uint8_t isd17xx_basic_init(isd17xx_type_t type)
     DRIVER_ISD17XX_LINK_SPI_READ(&gs_handle, isd17xx_interface_spi_read);
     DRIVER_ISD17XX_LINK_SPI_WRITE(&gs_handle, isd17xx_interface_spi_write);
     DRIVER_ISD17XX_LINK_SPI_TRANSMIT(&gs_handle, isd17xx_interface_spi_transmit);
+    DRIVER_ISD17XX_LINK_SPI_TRANSMIT_VECTOR(&gs_handle, isd17xx_interface_spi_transmit_vector);
     DRIVER_ISD17XX_LINK_DELAY_MS(&gs_handle, isd17xx_interface_delay_ms);
+    DRIVER_ISD17XX_LINK_DELAY_US(&gs_handle, isd17xx_interface_delay_us);
+    DRIVER_ISD17XX_LINK_GET_TIME_US(&gs_handle, isd17xx_interface_get_time_us);
     DRIVER_ISD17XX_LINK_DEBUG_PRINT(&gs_handle, isd17xx_interface_debug_print);
     DRIVER_ISD17XX_LINK_GPIO_RESET_INIT(&gs_handle, isd17xx_interface_gpio_reset_init);
     DRIVER_ISD17XX_LINK_GPIO_RESET_DEINIT(&gs_handle, isd17xx_interface_gpio_reset_deinit);
@@ -469,3 +472,186 @@ uint8_t isd17xx_basic_stop(void)
     
     return 0;
 }
+
+/**
+ * @brief      basic example snapshot
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 snapshot failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_snapshot(isd17xx_snapshot_t *snapshot)
+{
+    uint8_t res;
+    
+    /* read the status and points */
+    res = isd17xx_read_snapshot(&gs_handle, snapshot);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example set the command delay
+ * @param[in] ms delay in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 set command delay failed
+ * @note      0 means commands return at once and the caller polls the status
+ */
+uint8_t isd17xx_basic_set_command_delay(uint16_t ms)
+{
+    uint8_t res;
+    
+    /* set the command delay */
+    res = isd17xx_set_command_delay(&gs_handle, ms);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example start an erase
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start erase failed
+ * @note      returns at once, the caller polls the status
+ */
+uint8_t isd17xx_basic_start_erase(uint16_t start_addr, uint16_t end_addr)
+{
+    uint8_t res;
+    
+    /* set erase address */
+    res = isd17xx_set_erase(&gs_handle, start_addr, end_addr);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* erase */
+    res = isd17xx_erase(&gs_handle);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example start a play
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start play failed
+ * @note      sends set play alone, which starts at once on an idle chip or is queued
+ *            behind a running play, the caller reads the status to see if it was taken
+ */
+uint8_t isd17xx_basic_start_play(uint16_t start_addr, uint16_t end_addr)
+{
+    /* set play address, set play starts the play by itself */
+    if (isd17xx_set_play(&gs_handle, start_addr, end_addr) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  basic example start a global erase
+ * @return status code
+ *         - 0 success
+ *         - 1 start global erase failed
+ * @note   returns at once when the command delay is 0, the caller polls the status
+ */
+uint8_t isd17xx_basic_start_global_erase(void)
+{
+    /* global erase */
+    if (isd17xx_global_erase(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example get the status
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *status2 pointer to a status2 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_status(uint16_t *status1, uint8_t *status2)
+{
+    uint8_t res;
+    
+    /* get status */
+    res = isd17xx_get_status(&gs_handle, status1, status2);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     basic example set an apc field
+ * @param[in] field apc field
+ * @param[in] value field value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set apc field failed
+ * @note      none
+ */
+uint8_t isd17xx_basic_set_apc_field(isd17xx_apc_field_t field, uint8_t value)
+{
+    uint8_t res;
+    
+    /* set the field */
+    res = isd17xx_apc_set_field(&gs_handle, field, value);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      basic example get the delay statistics
+ * @param[out] *count pointer to a delay count buffer
+ * @param[out] *mean_us pointer to a mean overshoot buffer
+ * @param[out] *max_us pointer to a max overshoot buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get delay statistics failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_delay_statistics(uint32_t *count, uint32_t *mean_us, uint32_t *max_us)
+{
+    uint8_t res;
+    
+    /* get delay statistics */
+    res = isd17xx_get_delay_statistics(&gs_handle, count, mean_us, max_us);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
@@ -154,6 +154,92 @@ uint8_t isd17xx_basic_next(void);
  */
 uint8_t isd17xx_basic_stop(void);
 
+/**
+ * @brief      basic example snapshot
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 snapshot failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_snapshot(isd17xx_snapshot_t *snapshot);
+
+/**
+ * @brief     basic example set the command delay
+ * @param[in] ms delay in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 set command delay failed
+ * @note      0 means commands return at once and the caller polls the status
+ */
+uint8_t isd17xx_basic_set_command_delay(uint16_t ms);
+
+/**
+ * @brief     basic example start an erase
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start erase failed
+ * @note      returns at once, the caller polls the status
+ */
+uint8_t isd17xx_basic_start_erase(uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief     basic example start a play
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start play failed
+ * @note      sends set play alone, which starts at once on an idle chip or is queued
+ *            behind a running play, the caller reads the status to see if it was taken
+ */
+uint8_t isd17xx_basic_start_play(uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief  basic example start a global erase
+ * @return status code
+ *         - 0 success
+ *         - 1 start global erase failed
+ * @note   returns at once when the command delay is 0, the caller polls the status
+ */
+uint8_t isd17xx_basic_start_global_erase(void);
+
+/**
+ * @brief      basic example get the status
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *status2 pointer to a status2 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_status(uint16_t *status1, uint8_t *status2);
+
+/**
+ * @brief     basic example set an apc field
+ * @param[in] field apc field
+ * @param[in] value field value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set apc field failed
+ * @note      none
+ */
+uint8_t isd17xx_basic_set_apc_field(isd17xx_apc_field_t field, uint8_t value);
+
+/**
+ * @brief      basic example get the delay statistics
+ * @param[out] *count pointer to a delay count buffer
+ * @param[out] *mean_us pointer to a mean overshoot buffer
+ * @param[out] *max_us pointer to a max overshoot buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get delay statistics failed
+ * @note       none
+ */
+uint8_t isd17xx_basic_delay_statistics(uint32_t *count, uint32_t *mean_us, uint32_t *max_us);
+
 /**
  * @}
  */
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_coro_epoll.cpp
+ * @brief     driver isd17xx coroutine epoll example source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_coro_epoll.hpp"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/**
+ * @brief     play segments one after another
+ * @param[in] &loop device loop
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *segment pointer to a start and end address array
+ * @param[in] num segment number
+ * @return    task
+ * @note      none
+ */
+static isd17xx::Task a_isd17xx_coro_epoll_sequence(isd17xx::Loop &loop, isd17xx_handle_t *handle,
+                                                   const uint16_t (*segment)[2], size_t num)
+{
+    for (size_t i = 0; i < num; i++)
+    {
+        isd17xx::Result<void> res = co_await loop.play(handle, segment[i][0], segment[i][1]);
+        
+        if (!res)
+        {
+            co_return res;
+        }
+    }
+    
+    co_return isd17xx::Result<void>();
+}
+
+/**
+ * @brief     arm a timerfd
+ * @param[in] fd timerfd
+ * @param[in] ms time in ms
+ * @param[in] periodic true to repeat
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_coro_epoll_arm(int fd, uint32_t ms, bool periodic)
+{
+    struct itimerspec spec = {};
+    
+    spec.it_value.tv_sec = ms / 1000;
+    spec.it_value.tv_nsec = (long)(ms % 1000) * 1000000L;
+    if (periodic)
+    {
+        spec.it_interval = spec.it_value;
+    }
+    
+    return timerfd_settime(fd, 0, &spec, nullptr) != 0 ? 1 : 0;
+}
+
+/**
+ * @brief     coroutine epoll example play
+ * @param[in] type chip type
+ * @param[in] *segment pointer to a start and end address array
+ * @param[in] num segment number
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 0xFF timeout, the chip is stopped
+ * @note      linux only, plays the segments back to back from a coroutine
+ *            driven by an epoll loop with a poll timerfd and a timeout timerfd
+ */
+uint8_t isd17xx_coro_epoll_play(isd17xx_type_t type, const uint16_t (*segment)[2], size_t num, uint32_t timeout_ms)
+{
+    uint8_t res = 1;
+    int epfd;
+    int poll_fd;
+    int timeout_fd;
+    struct epoll_event ev = {};
+    
+    /* open and power up the chip, it is powered down and closed when dev leaves the scope */
+    isd17xx::Result<isd17xx::Device<>> dev = isd17xx::Device<>::open(type);
+    if (!dev)
+    {
+        isd17xx_interface_debug_print("isd17xx: %s failed with %d.\n", dev.error().function, dev.error().code);
+        
+        return 1;
+    }
+    
+    /* one epoll instance with a poll tick and a timeout */
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    poll_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    timeout_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((epfd < 0) || (poll_fd < 0) || (timeout_fd < 0))
+    {
+        isd17xx_interface_debug_print("isd17xx: create fd failed.\n");
+        
+        goto exit;
+    }
+    ev.events = EPOLLIN;
+    ev.data.fd = poll_fd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, poll_fd, &ev) != 0)
+    {
+        goto exit;
+    }
+    ev.data.fd = timeout_fd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, timeout_fd, &ev) != 0)
+    {
+        goto exit;
+    }
+    if ((a_isd17xx_coro_epoll_arm(poll_fd, ISD17XX_CORO_EPOLL_DEFAULT_POLL_MS, true) != 0) ||
+        (a_isd17xx_coro_epoll_arm(timeout_fd, timeout_ms, false) != 0))
+    {
+        goto exit;
+    }
+    
+    {
+        isd17xx::Loop loop;
+        isd17xx::Task task = a_isd17xx_coro_epoll_sequence(loop, dev.value().get(), segment, num);
+        
+        /* run until the coroutine returns */
+        while (!task.done())
+        {
+            struct epoll_event events[2];
+            uint64_t expirations;
+            int n;
+            
+            n = epoll_wait(epfd, events, 2, -1);
+            for (int i = 0; i < n; i++)
+            {
+                (void)read(events[i].data.fd, &expirations, sizeof(expirations));
+                if (events[i].data.fd == poll_fd)
+                {
+                    (void)loop.poll();
+                }
+                else
+                {
+                    isd17xx_interface_debug_print("isd17xx: timeout.\n");
+                    (void)loop.cancel_all();
+                }
+            }
+        }
+        
+        if (task.result())
+        {
+            res = 0;
+        }
+        else
+        {
+            isd17xx_interface_debug_print("isd17xx: %s failed with %d.\n", task.result().error().function, task.result().error().code);
+            res = task.result().error().code == isd17xx::ERROR_CANCELLED ? 0xFF : 1;
+        }
+    }
+    
+    exit:
+    if (timeout_fd >= 0)
+    {
+        (void)close(timeout_fd);
+    }
+    if (poll_fd >= 0)
+    {
+        (void)close(poll_fd);
+    }
+    if (epfd >= 0)
+    {
+        (void)close(epfd);
+    }
+    
+    return res;
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_coro_epoll.hpp
+ * @brief     driver isd17xx coroutine epoll example header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_CORO_EPOLL_HPP
+#define DRIVER_ISD17XX_CORO_EPOLL_HPP
+
+#include "driver_isd17xx_coro.hpp"
+
+/**
+ * @defgroup isd17xx_example_driver isd17xx example driver function
+ * @brief    isd17xx example driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx coroutine epoll example default definition
+ */
+#define ISD17XX_CORO_EPOLL_DEFAULT_POLL_MS        5        /**< 5ms poll period */
+
+/**
+ * @brief     coroutine epoll example play
+ * @param[in] type chip type
+ * @param[in] *segment pointer to a start and end address array
+ * @param[in] num segment number
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 0xFF timeout, the chip is stopped
+ * @note      linux only, plays the segments back to back from a coroutine
+ *            driven by an epoll loop with a poll timerfd and a timeout timerfd
+ */
+uint8_t isd17xx_coro_epoll_play(isd17xx_type_t type, const uint16_t (*segment)[2], size_t num, uint32_t timeout_ms);
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_interface_static.h
+ * @brief     driver isd17xx interface static header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_INTERFACE_STATIC_H
+#define DRIVER_ISD17XX_INTERFACE_STATIC_H
+
+#include "driver_isd17xx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_interface_static_driver isd17xx interface static driver function
+ * @brief    isd17xx interface static driver modules
+ * @ingroup  isd17xx_driver
+ * @note     build driver_isd17xx.c with -DISD17XX_STATIC_TRANSPORT=\"driver_isd17xx_interface_static.h\"
+ *           to call the interface directly instead of through the handle links,
+ *           these wrappers only remove the pointer call, the isd17xx_interface functions
+ *           are still extern, so the transport is only inlined with lto,
+ *           a port that wants it inlined without lto puts its bus access in these bodies
+ * @{
+ */
+
+/**
+ * @brief      static spi bus read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static inline uint8_t isd17xx_static_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return isd17xx_interface_spi_read(reg, buf, len);
+}
+
+/**
+ * @brief     static spi bus write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static inline uint8_t isd17xx_static_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return isd17xx_interface_spi_write(reg, buf, len);
+}
+
+/**
+ * @brief      static spi bus transmit
+ * @param[in]  *tx pointer to a tx data buffer
+ * @param[out] *rx pointer to a rx data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transmit failed
+ * @note       none
+ */
+static inline uint8_t isd17xx_static_spi_transmit(uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    return isd17xx_interface_spi_transmit(tx, rx, len);
+}
+
+/**
+ * @brief     static delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+static inline void isd17xx_static_delay_ms(uint32_t ms)
+{
+    isd17xx_interface_delay_ms(ms);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -105,6 +105,20 @@ uint8_t isd17xx_interface_spi_transmit(uint8_t *tx, uint8_t *rx, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief         interface spi bus transmit vector
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          every segment is a separate chip select cycle
+ */
+uint8_t isd17xx_interface_spi_transmit_vector(isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    return 0;
+}
+
 /**
  * @brief  interface gpio reset init
  * @return status code
@@ -152,6 +166,26 @@ void isd17xx_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      optional, the driver only uses it together with get_time_us
+ */
+void isd17xx_interface_delay_us(uint32_t us)
+{
+
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t isd17xx_interface_get_time_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_daemon.h
+ * @brief     raspberrypi4b driver isd17xx daemon header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_DAEMON_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_DAEMON_H
+
+#include "driver_isd17xx_basic.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_daemon isd17xx daemon function
+ * @brief    isd17xx daemon modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx daemon default definition
+ */
+#ifndef ISD17XX_DAEMON_DEFAULT_SOCKET
+    #define ISD17XX_DAEMON_DEFAULT_SOCKET        "/tmp/isd17xx.sock"        /**< default socket path */
+#endif
+#ifndef ISD17XX_DAEMON_MAX_CLIENT
+    #define ISD17XX_DAEMON_MAX_CLIENT            8                          /**< max connected client number */
+#endif
+#ifndef ISD17XX_DAEMON_POLL_MS
+    #define ISD17XX_DAEMON_POLL_MS               10                         /**< status poll interval while a client waits */
+#endif
+
+/**
+ * @brief isd17xx daemon protocol version definition
+ */
+#define ISD17XX_DAEMON_VERSION        0x01        /**< protocol version, the first byte of every message */
+
+/**
+ * @brief isd17xx daemon command enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_DAEMON_COMMAND_STATUS       = 0x00,        /**< read the status and points */
+    ISD17XX_DAEMON_COMMAND_PLAY         = 0x01,        /**< play a range */
+    ISD17XX_DAEMON_COMMAND_RECORD       = 0x02,        /**< record a range */
+    ISD17XX_DAEMON_COMMAND_ERASE        = 0x03,        /**< erase a range */
+    ISD17XX_DAEMON_COMMAND_GLOBAL_ERASE = 0x04,        /**< erase all */
+    ISD17XX_DAEMON_COMMAND_STOP         = 0x05,        /**< stop */
+    ISD17XX_DAEMON_COMMAND_SHUTDOWN     = 0x06,        /**< stop the daemon */
+} isd17xx_daemon_command_t;
+
+/**
+ * @brief isd17xx daemon flag enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_DAEMON_FLAG_WAIT = (1 << 0),        /**< answer after the chip is idle again */
+} isd17xx_daemon_flag_t;
+
+/**
+ * @brief isd17xx daemon request structure definition
+ * @note  8 bytes in host byte order, one request per seqpacket message
+ */
+typedef struct isd17xx_daemon_request_s
+{
+    uint8_t version;            /**< protocol version */
+    uint8_t command;            /**< command */
+    uint8_t flags;              /**< flags */
+    uint8_t reserved;           /**< reserved */
+    uint16_t start_addr;        /**< start address */
+    uint16_t end_addr;          /**< end address */
+} isd17xx_daemon_request_t;
+
+/**
+ * @brief isd17xx daemon response structure definition
+ * @note  12 bytes in host byte order, one response per request
+ */
+typedef struct isd17xx_daemon_response_s
+{
+    uint8_t version;              /**< protocol version */
+    uint8_t command;              /**< answered command */
+    uint8_t res;                  /**< status code of the command */
+    uint8_t status2;              /**< status2 after the command */
+    uint16_t status1;             /**< status1 after the command */
+    uint16_t play_point;          /**< play point after the command */
+    uint16_t record_point;        /**< record point after the command */
+    uint16_t reserved;            /**< reserved */
+} isd17xx_daemon_response_t;
+
+/**
+ * @brief     run the daemon
+ * @param[in] type chip type
+ * @param[in] *path pointer to a socket path
+ * @param[in] *shm_name pointer to a shm object name, NULL disables the status page
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a daemon is already running
+ * @note      the chip is initialized once and requests are served until
+ *            SIGINT, SIGTERM or a shutdown request, the status page is
+ *            updated after every command and while the chip is busy
+ */
+uint8_t isd17xx_daemon_run(isd17xx_type_t type, const char *path, const char *shm_name);
+
+/**
+ * @brief      send a request to the daemon
+ * @param[in]  *path pointer to a socket path
+ * @param[in]  *request pointer to a request structure
+ * @param[out] *response pointer to a response structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ *             - 4 no daemon is running
+ * @note       the version field is filled in, with ISD17XX_DAEMON_FLAG_WAIT
+ *             the call returns after the chip is idle again
+ */
+uint8_t isd17xx_daemon_request(const char *path, isd17xx_daemon_request_t *request, isd17xx_daemon_response_t *response);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
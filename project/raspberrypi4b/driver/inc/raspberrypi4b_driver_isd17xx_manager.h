@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_manager.h
+ * @brief     raspberrypi4b driver isd17xx manager header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_MANAGER_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_MANAGER_H
+
+#include "driver_isd17xx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_manager isd17xx manager function
+ * @brief    isd17xx manager modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx manager max device definition
+ * @note  one set of link functions is generated for every device
+ */
+#define ISD17XX_MANAGER_MAX_DEVICE        8        /**< max device number */
+
+/**
+ * @brief isd17xx manager max bus definition
+ */
+#define ISD17XX_MANAGER_MAX_BUS           8        /**< max spi bus number */
+
+/**
+ * @brief isd17xx manager poll interval definition
+ */
+#ifndef ISD17XX_MANAGER_POLL_MS
+    #define ISD17XX_MANAGER_POLL_MS       5        /**< status poll interval of devices without int line */
+#endif
+
+/**
+ * @brief isd17xx manager config structure definition
+ */
+typedef struct isd17xx_manager_config_s
+{
+    char spi_name[32];           /**< spidev name, e.g. /dev/spidev0.1 */
+    uint32_t spi_freq;           /**< spi frequency in hz */
+    int reset_line;              /**< reset gpio line, -1 means none */
+    int int_line;                /**< int gpio line, -1 means polling */
+    isd17xx_type_t type;         /**< chip type */
+} isd17xx_manager_config_t;
+
+/**
+ * @brief  manager init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t isd17xx_manager_init(void);
+
+/**
+ * @brief  manager deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all devices are removed
+ */
+uint8_t isd17xx_manager_deinit(void);
+
+/**
+ * @brief     add a device
+ * @param[in] id device id
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ *            - 4 id is invalid or used, or spi name is invalid
+ * @note      the chip is initialized and powered up, commands on it
+ *            do not sleep and isd17xx_manager_wait collects the results
+ */
+uint8_t isd17xx_manager_add(uint8_t id, const isd17xx_manager_config_t *config);
+
+/**
+ * @brief     remove a device
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ *            - 1 remove failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_remove(uint8_t id);
+
+/**
+ * @brief     get a device handle
+ * @param[in] id device id
+ * @return    pointer to an isd17xx handle structure, NULL if the id is invalid
+ * @note      none
+ */
+isd17xx_handle_t *isd17xx_manager_get_handle(uint8_t id);
+
+/**
+ * @brief      get the spi bus of a device
+ * @param[in]  id device id
+ * @param[out] *bus pointer to a bus number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 id is invalid
+ * @note       devices on the same bus share one bus lock
+ */
+uint8_t isd17xx_manager_get_bus(uint8_t id, uint8_t *bus);
+
+/**
+ * @brief      get the int line event fd of a device
+ * @param[in]  id device id
+ * @param[out] *fd pointer to a fd buffer, -1 means the device is polled
+ * @return     status code
+ *             - 0 success
+ *             - 4 id is invalid
+ * @note       the fd stays owned by the manager, e.g. for isd17xx_reactor_add
+ */
+uint8_t isd17xx_manager_get_int_fd(uint8_t id, int *fd);
+
+/**
+ * @brief     start playing on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_play(uint8_t id, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief     start recording on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_record(uint8_t id, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief     start erasing on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_erase(uint8_t id, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief      wait until devices are idle
+ * @param[in]  mask device id bit mask
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *done pointer to an idle device bit mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 5 timeout
+ * @note       devices with an int line are waited on together with poll(),
+ *             the others are polled every ISD17XX_MANAGER_POLL_MS
+ */
+uint8_t isd17xx_manager_wait(uint32_t mask, uint32_t timeout_ms, uint32_t *done);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_monitor.h
+ * @brief     raspberrypi4b driver isd17xx monitor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_MONITOR_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_MONITOR_H
+
+#include "driver_isd17xx_basic.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_monitor isd17xx monitor function
+ * @brief    isd17xx monitor modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx monitor default definition
+ */
+#ifndef ISD17XX_MONITOR_DEFAULT_RATE
+    #define ISD17XX_MONITOR_DEFAULT_RATE        1000         /**< default sample rate in Hz */
+#endif
+#ifndef ISD17XX_MONITOR_MAX_SAMPLE
+    #define ISD17XX_MONITOR_MAX_SAMPLE          8192         /**< sample ring size, power of 2 */
+#endif
+#ifndef ISD17XX_MONITOR_WRITE_BUFFER
+    #define ISD17XX_MONITOR_WRITE_BUFFER        65536        /**< output buffer size in bytes */
+#endif
+
+/**
+ * @brief isd17xx monitor format enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_MONITOR_FORMAT_CSV    = 0x00,        /**< one text line per sample */
+    ISD17XX_MONITOR_FORMAT_BINARY = 0x01,        /**< one isd17xx_monitor_sample_t per sample */
+} isd17xx_monitor_format_t;
+
+/**
+ * @brief isd17xx monitor sample structure definition
+ * @note  the binary output is an array of this structure in host byte order
+ */
+typedef struct isd17xx_monitor_sample_s
+{
+    uint64_t time_us;             /**< monotonic time before the read in us */
+    uint32_t index;               /**< sample index, missed samples leave a gap */
+    uint16_t status1;             /**< status1 */
+    uint16_t play_point;          /**< play point */
+    uint16_t record_point;        /**< record point */
+    uint8_t status2;              /**< status2 */
+    uint8_t res;                  /**< 0 if the read succeeded */
+    uint32_t read_us;             /**< spi read time in us */
+} isd17xx_monitor_sample_t;
+
+/**
+ * @brief isd17xx monitor config structure definition
+ */
+typedef struct isd17xx_monitor_config_s
+{
+    uint32_t rate_hz;                       /**< sample rate, 0 samples as fast as the spi allows */
+    uint32_t duration_ms;                   /**< run time, 0 runs until SIGINT or SIGTERM */
+    isd17xx_monitor_format_t format;        /**< output format */
+    const char *path;                       /**< output file, NULL for stdout */
+} isd17xx_monitor_config_t;
+
+/**
+ * @brief isd17xx monitor report structure definition
+ */
+typedef struct isd17xx_monitor_report_s
+{
+    uint32_t sample_count;        /**< written sample number */
+    uint32_t missed_count;        /**< samples skipped because the deadline had passed */
+    uint32_t dropped_count;       /**< samples lost because the writer fell behind */
+    uint32_t error_count;         /**< failed read number */
+    uint32_t max_late_us;         /**< max time a sample started after its deadline */
+    uint32_t max_read_us;         /**< max spi read time */
+    uint64_t wall_us;             /**< run time in us */
+} isd17xx_monitor_report_t;
+
+/**
+ * @brief      run the monitor
+ * @param[in]  type chip type
+ * @param[in]  *config pointer to a config structure
+ * @param[out] *report pointer to a report structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ * @note       samples are taken on absolute deadlines and handed to a writer
+ *             thread through a ring, so the output never slows the sampling,
+ *             the chip is reset and powered up by the init and powered down by the deinit,
+ *             so a play, record or erase running before the call is not observed
+ */
+uint8_t isd17xx_monitor_run(isd17xx_type_t type, const isd17xx_monitor_config_t *config,
+                            isd17xx_monitor_report_t *report);
+
+/**
+ * @brief     print a monitor report
+ * @param[in] *report pointer to a report structure
+ * @note      printed to stderr, stdout may carry the samples
+ */
+void isd17xx_monitor_print_report(const isd17xx_monitor_report_t *report);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_pool.h
+ * @brief     raspberrypi4b driver isd17xx pool header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_POOL_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_POOL_H
+
+#include "raspberrypi4b_driver_isd17xx_manager.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_pool isd17xx pool function
+ * @brief    isd17xx pool modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx pool max definition
+ */
+#ifndef ISD17XX_POOL_MAX_TASK
+    #define ISD17XX_POOL_MAX_TASK        16        /**< max queued task number of one device */
+#endif
+#ifndef ISD17XX_POOL_POLL_MS
+    #define ISD17XX_POOL_POLL_MS         5         /**< worker status poll interval in ms */
+#endif
+#ifndef ISD17XX_POOL_SETTLE_MS
+    #define ISD17XX_POOL_SETTLE_MS       20        /**< time before an idle status ends a task */
+#endif
+
+/**
+ * @brief isd17xx pool task type enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_POOL_TASK_GLOBAL_ERASE = 0x00,        /**< global erase */
+    ISD17XX_POOL_TASK_ERASE        = 0x01,        /**< erase a range */
+    ISD17XX_POOL_TASK_RECORD       = 0x02,        /**< record a range */
+    ISD17XX_POOL_TASK_PLAY         = 0x03,        /**< play a range */
+} isd17xx_pool_task_type_t;
+
+/**
+ * @brief isd17xx pool task structure definition
+ */
+typedef struct isd17xx_pool_task_s
+{
+    isd17xx_pool_task_type_t type;        /**< task type */
+    uint16_t start_addr;                  /**< start address */
+    uint16_t end_addr;                    /**< end address */
+    uint32_t duration_ms;                 /**< record or play time, 0 means until the end of the range */
+} isd17xx_pool_task_t;
+
+/**
+ * @brief isd17xx pool report structure definition
+ */
+typedef struct isd17xx_pool_report_s
+{
+    uint32_t task_count;        /**< finished task number */
+    uint32_t failed_count;      /**< failed task number */
+    uint8_t worker_count;       /**< worker number, one per spi bus */
+    uint64_t wall_us;           /**< wall time in us */
+    uint64_t serial_us;         /**< sum of all task times, the serial baseline in us */
+} isd17xx_pool_report_t;
+
+/**
+ * @brief     submit a task to a device queue
+ * @param[in] id device id
+ * @param[in] *task pointer to a task structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 id is invalid
+ *            - 5 queue is full
+ * @note      tasks of one device run in order
+ */
+uint8_t isd17xx_pool_submit(uint8_t id, const isd17xx_pool_task_t *task);
+
+/**
+ * @brief      run all queued tasks
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *report pointer to a report structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 5 timeout
+ * @note       one worker thread is started per spi bus, each worker keeps
+ *             all of its chips busy and the queues are empty after it returns
+ */
+uint8_t isd17xx_pool_run(uint32_t timeout_ms, isd17xx_pool_report_t *report);
+
+/**
+ * @brief     print a report
+ * @param[in] *report pointer to a report structure
+ * @note      none
+ */
+void isd17xx_pool_print_report(const isd17xx_pool_report_t *report);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_reactor.h
+ * @brief     raspberrypi4b driver isd17xx reactor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_REACTOR_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_REACTOR_H
+
+#include "driver_isd17xx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_reactor isd17xx reactor function
+ * @brief    isd17xx reactor modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx reactor max definition
+ */
+#ifndef ISD17XX_REACTOR_MAX_DEVICE
+    #define ISD17XX_REACTOR_MAX_DEVICE        256       /**< max device number of one reactor */
+#endif
+#ifndef ISD17XX_REACTOR_POLL_MS
+    #define ISD17XX_REACTOR_POLL_MS           5         /**< status poll interval of devices without int line */
+#endif
+
+/**
+ * @brief isd17xx reactor operation enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_REACTOR_OP_PLAY   = 0x00,        /**< play a range */
+    ISD17XX_REACTOR_OP_RECORD = 0x01,        /**< record a range */
+    ISD17XX_REACTOR_OP_ERASE  = 0x02,        /**< erase a range */
+} isd17xx_reactor_op_t;
+
+/**
+ * @brief isd17xx reactor result enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_REACTOR_RESULT_DONE      = 0x00,        /**< the chip raised int */
+    ISD17XX_REACTOR_RESULT_FAILED    = 0x01,        /**< spi failed or command error */
+    ISD17XX_REACTOR_RESULT_TIMEOUT   = 0x05,        /**< timeout, the chip is stopped */
+    ISD17XX_REACTOR_RESULT_CANCELLED = 0x06,        /**< cancelled, the chip is stopped */
+} isd17xx_reactor_result_t;
+
+/**
+ * @brief isd17xx reactor device structure definition
+ */
+typedef struct isd17xx_reactor_device_s
+{
+    isd17xx_handle_t *handle;                                                                  /**< device handle */
+    int int_fd;                                                                                /**< int line event fd, -1 means polling */
+    uint8_t busy;                                                                              /**< busy flag */
+    uint8_t stopping;                                                                          /**< stop sent flag */
+    isd17xx_reactor_result_t result;                                                           /**< result reported once the stop is collected */
+    uint64_t poll_us;                                                                          /**< next status poll time in us */
+    uint64_t timeout_us;                                                                       /**< operation deadline in us */
+    void (*callback)(isd17xx_handle_t *handle, isd17xx_reactor_result_t result, void *arg);    /**< completion callback */
+    void *arg;                                                                                 /**< callback argument */
+} isd17xx_reactor_device_t;
+
+/**
+ * @brief isd17xx reactor structure definition
+ */
+typedef struct isd17xx_reactor_s
+{
+    int timer_fd;                                                   /**< deadline timerfd */
+    uint64_t armed_us;                                              /**< armed deadline in us, 0 means disarmed */
+    uint16_t num;                                                   /**< device number */
+    isd17xx_reactor_device_t device[ISD17XX_REACTOR_MAX_DEVICE];    /**< device table */
+} isd17xx_reactor_t;
+
+/**
+ * @brief     reactor init
+ * @param[in] *reactor pointer to a reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 reactor is NULL
+ * @note      none
+ */
+uint8_t isd17xx_reactor_init(isd17xx_reactor_t *reactor);
+
+/**
+ * @brief     reactor deinit
+ * @param[in] *reactor pointer to a reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ * @note      pending operations are dropped without callbacks, the chips keep running
+ */
+uint8_t isd17xx_reactor_deinit(isd17xx_reactor_t *reactor);
+
+/**
+ * @brief     add a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an initialized isd17xx handle structure
+ * @param[in] int_fd int line event fd, -1 means polling
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor or handle is NULL
+ *            - 4 reactor is full or handle is added
+ * @note      the int fd is a gpiod falling edge event fd, e.g. from isd17xx_manager_get_int_fd,
+ *            get_fds has to be called again after a device is added or removed
+ */
+uint8_t isd17xx_reactor_add(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle, int int_fd,
+                            void (*callback)(isd17xx_handle_t *handle, isd17xx_reactor_result_t result, void *arg),
+                            void *arg);
+
+/**
+ * @brief     remove a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ * @note      a pending operation is dropped without callback
+ */
+uint8_t isd17xx_reactor_remove(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle);
+
+/**
+ * @brief     start an operation
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] op operation
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @param[in] timeout_ms timeout in ms, 0 means none
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ *            - 5 device is busy
+ *            - 6 op is invalid
+ * @note      the command is sent at once without the command delay and the callback runs from on_readable,
+ *            a stale interrupt is cleared first so it can not end the new operation
+ */
+uint8_t isd17xx_reactor_submit(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle, isd17xx_reactor_op_t op,
+                               uint16_t start_addr, uint16_t end_addr, uint32_t timeout_ms);
+
+/**
+ * @brief     cancel an operation
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ *            - 5 device is not busy
+ * @note      a stop frame is sent at once and the next on_readable tick runs the callback
+ *            with ISD17XX_REACTOR_RESULT_CANCELLED, the device stays busy until then
+ */
+uint8_t isd17xx_reactor_cancel(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle);
+
+/**
+ * @brief         get the pollable fds
+ * @param[in]     *reactor pointer to a reactor structure
+ * @param[out]    *fds pointer to a fd buffer
+ * @param[in,out] *num pointer to a fd number buffer, the buffer size in and the fd number out
+ * @return        status code
+ *                - 0 success
+ *                - 2 reactor is NULL
+ *                - 4 buffer is too small
+ * @note          the timerfd comes first followed by the int fds, register them all with EPOLLIN
+ */
+uint8_t isd17xx_reactor_get_fds(isd17xx_reactor_t *reactor, int *fds, uint16_t *num);
+
+/**
+ * @brief     handle a readable fd
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] fd readable fd
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 reactor is NULL
+ *            - 4 fd is unknown
+ * @note      a timer tick polls devices without int line, stops timed out operations and collects the stops,
+ *            an int event services its device with one clear interrupt frame
+ */
+uint8_t isd17xx_reactor_on_readable(isd17xx_reactor_t *reactor, int fd);
+
+/**
+ * @brief      get the next deadline
+ * @param[in]  *reactor pointer to a reactor structure
+ * @param[out] *deadline_us pointer to a monotonic deadline buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 reactor is NULL
+ *             - 4 no deadline
+ * @note       for loops that prefer an epoll_wait timeout to the timerfd, call
+ *             on_readable with the timerfd once the deadline has passed
+ */
+uint8_t isd17xx_reactor_next_deadline(isd17xx_reactor_t *reactor, uint64_t *deadline_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
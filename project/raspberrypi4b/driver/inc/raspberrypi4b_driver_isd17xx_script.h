@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_script.h
+ * @brief     raspberrypi4b driver isd17xx script header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_SCRIPT_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_SCRIPT_H
+
+#include "driver_isd17xx_basic.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_script isd17xx script function
+ * @brief    isd17xx script modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx script max definition
+ */
+#ifndef ISD17XX_SCRIPT_MAX_STEP
+    #define ISD17XX_SCRIPT_MAX_STEP        256        /**< max step number of one script */
+#endif
+#ifndef ISD17XX_SCRIPT_MAX_LINE
+    #define ISD17XX_SCRIPT_MAX_LINE        128        /**< max line length */
+#endif
+#ifndef ISD17XX_SCRIPT_POLL_MS
+    #define ISD17XX_SCRIPT_POLL_MS         1          /**< status poll period in ms */
+#endif
+
+/**
+ * @brief isd17xx script op enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_SCRIPT_OP_ERASE        = 0x00,        /**< erase start end */
+    ISD17XX_SCRIPT_OP_RECORD       = 0x01,        /**< record start end */
+    ISD17XX_SCRIPT_OP_PLAY         = 0x02,        /**< play start end */
+    ISD17XX_SCRIPT_OP_GLOBAL_ERASE = 0x03,        /**< global-erase */
+    ISD17XX_SCRIPT_OP_STOP         = 0x04,        /**< stop */
+    ISD17XX_SCRIPT_OP_WAIT         = 0x05,        /**< wait until the chip is idle */
+    ISD17XX_SCRIPT_OP_DELAY        = 0x06,        /**< delay ms */
+    ISD17XX_SCRIPT_OP_SET          = 0x07,        /**< set field value */
+} isd17xx_script_op_t;
+
+/**
+ * @brief isd17xx script step structure definition
+ */
+typedef struct isd17xx_script_step_s
+{
+    uint8_t op;                  /**< script op */
+    uint8_t field;               /**< apc field of a set step */
+    uint16_t line;               /**< line number in the file */
+    uint16_t start_addr;         /**< start address */
+    uint16_t end_addr;           /**< end address */
+    uint32_t value;              /**< delay in ms or field value */
+} isd17xx_script_step_t;
+
+/**
+ * @brief isd17xx script structure definition
+ */
+typedef struct isd17xx_script_s
+{
+    isd17xx_script_step_t step[ISD17XX_SCRIPT_MAX_STEP];        /**< steps */
+    uint16_t num;                                               /**< step number */
+} isd17xx_script_t;
+
+/**
+ * @brief      load a script file
+ * @param[in]  *path pointer to a script path
+ * @param[out] *script pointer to a script structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 handle is NULL
+ *             - 4 a line is invalid
+ *             - 5 too many steps
+ * @note       the whole file is checked before anything is sent to the chip,
+ *             one step per line and # starts a comment
+ */
+uint8_t isd17xx_script_load(const char *path, isd17xx_script_t *script);
+
+/**
+ * @brief     run a loaded script in one session
+ * @param[in] type chip type
+ * @param[in] *script pointer to a script structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ * @note      the chip is initialized once, every chip step is sent as soon as
+ *            the chip accepts it and the timing of every step is printed
+ */
+uint8_t isd17xx_script_run(isd17xx_type_t type, const isd17xx_script_t *script);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_shm.h
+ * @brief     raspberrypi4b driver isd17xx shm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_ISD17XX_SHM_H
+#define RASPBERRYPI4B_DRIVER_ISD17XX_SHM_H
+
+#include "driver_isd17xx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_shm isd17xx shm function
+ * @brief    isd17xx shm modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx shm default definition
+ */
+#ifndef ISD17XX_SHM_DEFAULT_NAME
+    #define ISD17XX_SHM_DEFAULT_NAME        "/isd17xx"        /**< default shm object name */
+#endif
+#ifndef ISD17XX_SHM_MAX_DEVICE
+    #define ISD17XX_SHM_MAX_DEVICE          8                 /**< max device number of one page */
+#endif
+#ifndef ISD17XX_SHM_MAX_RETRY
+    #define ISD17XX_SHM_MAX_RETRY           1000              /**< max read retries while the publisher writes */
+#endif
+
+/**
+ * @brief isd17xx shm page definition
+ */
+#define ISD17XX_SHM_MAGIC             0x49534431U        /**< "ISD1" */
+#define ISD17XX_SHM_VERSION           0x0001             /**< page layout version */
+#define ISD17XX_SHM_NO_COMMAND        0xFF               /**< publish without a command */
+
+/**
+ * @brief isd17xx shm device structure definition
+ * @note  guarded by its own sequence, odd while the publisher writes it
+ */
+typedef struct isd17xx_shm_device_s
+{
+    uint32_t sequence;             /**< seqlock sequence */
+    uint8_t valid;                 /**< published at least once */
+    uint8_t status2;               /**< status2 */
+    uint16_t status1;              /**< status1 */
+    uint16_t play_point;           /**< play point */
+    uint16_t record_point;         /**< record point */
+    uint8_t last_command;          /**< last daemon command, ISD17XX_SHM_NO_COMMAND if none */
+    uint8_t last_res;              /**< status code of the last command */
+    uint16_t reserved;             /**< reserved */
+    uint32_t update_count;         /**< published snapshot number */
+    uint32_t command_count;        /**< command number */
+    uint32_t error_count;          /**< failed command number */
+    uint64_t update_us;            /**< monotonic time of the last update in us */
+    uint64_t command_us;           /**< monotonic time of the last command in us */
+} isd17xx_shm_device_t;
+
+/**
+ * @brief isd17xx shm page structure definition
+ */
+typedef struct isd17xx_shm_page_s
+{
+    uint32_t magic;                                          /**< ISD17XX_SHM_MAGIC */
+    uint16_t version;                                        /**< ISD17XX_SHM_VERSION */
+    uint16_t device_num;                                     /**< device number */
+    uint32_t pid;                                            /**< publisher pid */
+    uint32_t reserved;                                       /**< reserved */
+    isd17xx_shm_device_t device[ISD17XX_SHM_MAX_DEVICE];     /**< device table */
+} isd17xx_shm_page_t;
+
+/**
+ * @brief isd17xx shm handle structure definition
+ */
+typedef struct isd17xx_shm_s
+{
+    isd17xx_shm_page_t *page;        /**< mapped page */
+    char name[32];                   /**< shm object name */
+    uint8_t owner;                   /**< 1 for the publisher */
+} isd17xx_shm_t;
+
+/**
+ * @brief      create and map the page as the publisher
+ * @param[in]  *name pointer to a shm object name
+ * @param[in]  device_num device number
+ * @param[out] *shm pointer to a shm handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ *             - 2 handle is NULL
+ *             - 4 name or device number is invalid
+ * @note       an old page of the same name is replaced
+ */
+uint8_t isd17xx_shm_create(const char *name, uint16_t device_num, isd17xx_shm_t *shm);
+
+/**
+ * @brief     unmap and remove the page
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_shm_destroy(isd17xx_shm_t *shm);
+
+/**
+ * @brief     publish a device snapshot
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] id device id
+ * @param[in] *snapshot pointer to a snapshot structure
+ * @param[in] command finished command, ISD17XX_SHM_NO_COMMAND for a plain status update
+ * @param[in] res status code of the command
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      no syscall, readers never block the publisher
+ */
+uint8_t isd17xx_shm_publish(isd17xx_shm_t *shm, uint16_t id, const isd17xx_snapshot_t *snapshot,
+                            uint8_t command, uint8_t res);
+
+/**
+ * @brief      map the page as a reader
+ * @param[in]  *name pointer to a shm object name
+ * @param[out] *shm pointer to a shm handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 handle is NULL
+ *             - 4 page is invalid
+ * @note       none
+ */
+uint8_t isd17xx_shm_open(const char *name, isd17xx_shm_t *shm);
+
+/**
+ * @brief     unmap the page
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_shm_close(isd17xx_shm_t *shm);
+
+/**
+ * @brief      read a consistent device snapshot
+ * @param[in]  *shm pointer to a shm handle structure
+ * @param[in]  id device id
+ * @param[out] *device pointer to a device structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 id is invalid
+ *             - 5 nothing is published yet
+ *             - 6 page is busy
+ * @note       no syscall and no spi traffic, retries while the publisher writes,
+ *             gives up after ISD17XX_SHM_MAX_RETRY tries so a publisher that died
+ *             mid write can not hang the reader
+ */
+uint8_t isd17xx_shm_read(isd17xx_shm_t *shm, uint16_t id, isd17xx_shm_device_t *device);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
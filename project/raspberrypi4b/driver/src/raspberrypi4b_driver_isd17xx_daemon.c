@@ -0,0 +1,545 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_daemon.c
+ * @brief     raspberrypi4b driver isd17xx daemon source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_daemon.h"
+#include "raspberrypi4b_driver_isd17xx_shm.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief global var definition
+ */
+static volatile sig_atomic_t gs_stop;        /**< stop flag */
+static isd17xx_shm_t gs_shm;                 /**< status page */
+static uint8_t gs_shm_enable;                /**< status page enable */
+
+/**
+ * @brief     signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_isd17xx_daemon_signal(int sig)
+{
+    (void)sig;
+    gs_stop = 1;
+}
+
+/**
+ * @brief      fill a socket address
+ * @param[in]  *path pointer to a socket path
+ * @param[out] *addr pointer to a socket address structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 path is too long
+ * @note       none
+ */
+static uint8_t a_isd17xx_daemon_address(const char *path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(struct sockaddr_un));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path))
+    {
+        isd17xx_interface_debug_print("isd17xx: socket path is too long.\n");
+        
+        return 1;
+    }
+    strcpy(addr->sun_path, path);
+    
+    return 0;
+}
+
+/**
+ * @brief     fill the status fields of a response
+ * @param[in] *response pointer to a response structure
+ * @note      a failed read marks a successful command as failed
+ */
+static void a_isd17xx_daemon_status(isd17xx_daemon_response_t *response)
+{
+    isd17xx_snapshot_t snapshot;
+    
+    if (isd17xx_basic_snapshot(&snapshot) != 0)
+    {
+        if (response->res == 0)
+        {
+            response->res = 1;
+        }
+        
+        return;
+    }
+    response->status1 = snapshot.status1;
+    response->status2 = snapshot.status2;
+    response->play_point = snapshot.play_point;
+    response->record_point = snapshot.record_point;
+}
+
+/**
+ * @brief     publish a response to the status page
+ * @param[in] *response pointer to a response structure
+ * @param[in] command finished command, ISD17XX_SHM_NO_COMMAND for a plain status update
+ * @note      the response already holds the state, so no extra frame is sent
+ */
+static void a_isd17xx_daemon_publish(const isd17xx_daemon_response_t *response, uint8_t command)
+{
+    isd17xx_snapshot_t snapshot;
+    
+    if (gs_shm_enable == 0)
+    {
+        return;
+    }
+    snapshot.status1 = response->status1;
+    snapshot.status2 = response->status2;
+    snapshot.play_point = response->play_point;
+    snapshot.record_point = response->record_point;
+    (void)isd17xx_shm_publish(&gs_shm, 0, &snapshot, command, response->res);
+}
+
+/**
+ * @brief      run a request
+ * @param[in]  *request pointer to a request structure
+ * @param[out] *response pointer to a response structure
+ * @note       the chip commands return at once, waiting is done by the caller
+ */
+static void a_isd17xx_daemon_execute(const isd17xx_daemon_request_t *request, isd17xx_daemon_response_t *response)
+{
+    memset(response, 0, sizeof(isd17xx_daemon_response_t));
+    response->version = ISD17XX_DAEMON_VERSION;
+    response->command = request->command;
+    
+    switch (request->command)
+    {
+        case ISD17XX_DAEMON_COMMAND_STATUS :
+        {
+            response->res = 0;
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_PLAY :
+        {
+            response->res = isd17xx_basic_play(request->start_addr, request->end_addr);
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_RECORD :
+        {
+            response->res = isd17xx_basic_record(request->start_addr, request->end_addr);
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_ERASE :
+        {
+            response->res = isd17xx_basic_start_erase(request->start_addr, request->end_addr);
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_GLOBAL_ERASE :
+        {
+            response->res = isd17xx_basic_start_global_erase();
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_STOP :
+        {
+            response->res = isd17xx_basic_stop();
+            
+            break;
+        }
+        case ISD17XX_DAEMON_COMMAND_SHUTDOWN :
+        {
+            gs_stop = 1;
+            response->res = 0;
+            
+            break;
+        }
+        default :
+        {
+            response->res = 5;
+            
+            return;
+        }
+    }
+    
+    /* report the state after the command */
+    a_isd17xx_daemon_status(response);
+}
+
+/**
+ * @brief     run the daemon
+ * @param[in] type chip type
+ * @param[in] *path pointer to a socket path
+ * @param[in] *shm_name pointer to a shm object name, NULL disables the status page
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a daemon is already running
+ * @note      the chip is initialized once and requests are served until
+ *            SIGINT, SIGTERM or a shutdown request, the status page is
+ *            updated after every command and while the chip is busy
+ */
+uint8_t isd17xx_daemon_run(isd17xx_type_t type, const char *path, const char *shm_name)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t busy;
+    uint8_t waiting;
+    int fd;
+    int n;
+    int listen_fd;
+    int client[ISD17XX_DAEMON_MAX_CLIENT];
+    uint8_t wait_flag[ISD17XX_DAEMON_MAX_CLIENT];
+    isd17xx_daemon_response_t wait_response[ISD17XX_DAEMON_MAX_CLIENT];
+    struct pollfd fds[ISD17XX_DAEMON_MAX_CLIENT + 1];
+    struct sockaddr_un addr;
+    struct sigaction action;
+    isd17xx_daemon_request_t request;
+    isd17xx_daemon_response_t response;
+    
+    /* check the path */
+    if (a_isd17xx_daemon_address(path, &addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* refuse to replace a running daemon */
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        perror("isd17xx: socket failed.\n");
+        
+        return 1;
+    }
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: a daemon is already running on %s.\n", path);
+        (void)close(fd);
+        
+        return 4;
+    }
+    (void)close(fd);
+    
+    /* init the chip once */
+    if (isd17xx_basic_init(type) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: basic init failed.\n");
+        
+        return 1;
+    }
+    
+    /* commands must not block the other clients, waiting clients are polled */
+    if (isd17xx_basic_set_command_delay(0) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: basic set command delay failed.\n");
+        (void)isd17xx_basic_deinit();
+        
+        return 1;
+    }
+    
+    /* create the status page */
+    gs_shm_enable = 0;
+    if (shm_name != NULL)
+    {
+        if (isd17xx_shm_create(shm_name, 1, &gs_shm) != 0)
+        {
+            isd17xx_interface_debug_print("isd17xx: shm create failed.\n");
+            (void)isd17xx_basic_deinit();
+            
+            return 1;
+        }
+        gs_shm_enable = 1;
+    }
+    
+    /* listen */
+    listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0)
+    {
+        perror("isd17xx: socket failed.\n");
+        (void)isd17xx_shm_destroy(&gs_shm);
+        (void)isd17xx_basic_deinit();
+        
+        return 1;
+    }
+    (void)unlink(path);
+    if ((bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+        (listen(listen_fd, ISD17XX_DAEMON_MAX_CLIENT) != 0))
+    {
+        perror("isd17xx: bind failed.\n");
+        (void)close(listen_fd);
+        (void)isd17xx_shm_destroy(&gs_shm);
+        (void)isd17xx_basic_deinit();
+        
+        return 1;
+    }
+    
+    /* stop on SIGINT and SIGTERM, poll is interrupted and not restarted */
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = a_isd17xx_daemon_signal;
+    (void)sigemptyset(&action.sa_mask);
+    (void)sigaction(SIGINT, &action, NULL);
+    (void)sigaction(SIGTERM, &action, NULL);
+    gs_stop = 0;
+    for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+    {
+        client[i] = -1;
+        wait_flag[i] = 0;
+    }
+    
+    /* first status for the readers */
+    memset(&response, 0, sizeof(response));
+    a_isd17xx_daemon_status(&response);
+    a_isd17xx_daemon_publish(&response, ISD17XX_SHM_NO_COMMAND);
+    busy = 0;
+    isd17xx_interface_debug_print("isd17xx: daemon is listening on %s.\n", path);
+    
+    res = 0;
+    while (gs_stop == 0)
+    {
+        /* listen socket first, then the clients */
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        waiting = 0;
+        for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+        {
+            fds[i + 1].fd = client[i];
+            fds[i + 1].events = POLLIN;
+            fds[i + 1].revents = 0;
+            if (wait_flag[i] != 0)
+            {
+                waiting = 1;
+            }
+        }
+        
+        /* sleep until a request comes, or until the next status poll if a client waits */
+        /* or the status page follows a running operation */
+        n = poll(fds, ISD17XX_DAEMON_MAX_CLIENT + 1, ((waiting != 0) || (busy != 0)) ? ISD17XX_DAEMON_POLL_MS : -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("isd17xx: poll failed.\n");
+            res = 1;
+            
+            break;
+        }
+        
+        /* accept a new client */
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+            fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0)
+            {
+                for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+                {
+                    if (client[i] < 0)
+                    {
+                        client[i] = fd;
+                        
+                        break;
+                    }
+                }
+                if (i == ISD17XX_DAEMON_MAX_CLIENT)
+                {
+                    isd17xx_interface_debug_print("isd17xx: too many clients.\n");
+                    (void)close(fd);
+                }
+            }
+        }
+        
+        /* serve the requests */
+        for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+        {
+            if ((client[i] < 0) || (fds[i + 1].revents == 0))
+            {
+                continue;
+            }
+            n = (int)recv(client[i], &request, sizeof(request), 0);
+            if (n <= 0)
+            {
+                (void)close(client[i]);
+                client[i] = -1;
+                wait_flag[i] = 0;
+                
+                continue;
+            }
+            if ((n != (int)sizeof(request)) || (request.version != ISD17XX_DAEMON_VERSION))
+            {
+                memset(&response, 0, sizeof(response));
+                response.version = ISD17XX_DAEMON_VERSION;
+                response.command = request.command;
+                response.res = 5;
+            }
+            else
+            {
+                a_isd17xx_daemon_execute(&request, &response);
+                a_isd17xx_daemon_publish(&response, (request.command == ISD17XX_DAEMON_COMMAND_STATUS) ?
+                                         ISD17XX_SHM_NO_COMMAND : request.command);
+                if ((gs_shm_enable != 0) &&
+                    ((response.status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) != 0))
+                {
+                    busy = 1;
+                }
+                
+                /* answer later if the client waits for the chip */
+                if (((request.flags & ISD17XX_DAEMON_FLAG_WAIT) != 0) && (response.res == 0) &&
+                    (request.command >= ISD17XX_DAEMON_COMMAND_PLAY) &&
+                    (request.command <= ISD17XX_DAEMON_COMMAND_GLOBAL_ERASE))
+                {
+                    wait_flag[i] = 1;
+                    wait_response[i] = response;
+                    
+                    continue;
+                }
+            }
+            (void)send(client[i], &response, sizeof(response), MSG_NOSIGNAL);
+        }
+        
+        /* publish the state and answer the waiting clients once the chip is idle */
+        if ((waiting != 0) || (busy != 0))
+        {
+            memset(&response, 0, sizeof(response));
+            a_isd17xx_daemon_status(&response);
+            if (response.res != 0)
+            {
+                response.status2 = 0;
+            }
+            else
+            {
+                a_isd17xx_daemon_publish(&response, ISD17XX_SHM_NO_COMMAND);
+            }
+            busy = ((response.status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) != 0) ? 1 : 0;
+            if ((busy == 0) && (waiting != 0))
+            {
+                for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+                {
+                    if ((wait_flag[i] == 0) || (client[i] < 0))
+                    {
+                        continue;
+                    }
+                    a_isd17xx_daemon_status(&wait_response[i]);
+                    (void)send(client[i], &wait_response[i], sizeof(isd17xx_daemon_response_t), MSG_NOSIGNAL);
+                    wait_flag[i] = 0;
+                }
+            }
+        }
+    }
+    
+    /* close all */
+    for (i = 0; i < ISD17XX_DAEMON_MAX_CLIENT; i++)
+    {
+        if (client[i] >= 0)
+        {
+            (void)close(client[i]);
+        }
+    }
+    (void)close(listen_fd);
+    (void)unlink(path);
+    if (gs_shm_enable != 0)
+    {
+        (void)isd17xx_shm_destroy(&gs_shm);
+        gs_shm_enable = 0;
+    }
+    (void)isd17xx_basic_deinit();
+    isd17xx_interface_debug_print("isd17xx: daemon is stopped.\n");
+    
+    return res;
+}
+
+/**
+ * @brief      send a request to the daemon
+ * @param[in]  *path pointer to a socket path
+ * @param[in]  *request pointer to a request structure
+ * @param[out] *response pointer to a response structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ *             - 4 no daemon is running
+ * @note       the version field is filled in, with ISD17XX_DAEMON_FLAG_WAIT
+ *             the call returns after the chip is idle again
+ */
+uint8_t isd17xx_daemon_request(const char *path, isd17xx_daemon_request_t *request, isd17xx_daemon_response_t *response)
+{
+    int fd;
+    ssize_t n;
+    struct sockaddr_un addr;
+    
+    /* check the path */
+    if (a_isd17xx_daemon_address(path, &addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* connect */
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        perror("isd17xx: socket failed.\n");
+        
+        return 1;
+    }
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: no daemon is running on %s.\n", path);
+        (void)close(fd);
+        
+        return 4;
+    }
+    
+    /* one message each way */
+    request->version = ISD17XX_DAEMON_VERSION;
+    if (send(fd, request, sizeof(isd17xx_daemon_request_t), MSG_NOSIGNAL) != (ssize_t)sizeof(isd17xx_daemon_request_t))
+    {
+        perror("isd17xx: send failed.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    n = recv(fd, response, sizeof(isd17xx_daemon_response_t), 0);
+    (void)close(fd);
+    if ((n != (ssize_t)sizeof(isd17xx_daemon_response_t)) || (response->version != ISD17XX_DAEMON_VERSION))
+    {
+        isd17xx_interface_debug_print("isd17xx: response is invalid.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -37,7 +37,9 @@
 #include "driver_isd17xx_interface.h"
 #include "spi.h"
 #include "wire.h"
+#include <errno.h>
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief spi device name definition
@@ -118,6 +120,37 @@ uint8_t isd17xx_interface_spi_transmit(uint8_t *tx, uint8_t *rx, uint16_t len)
     return spi_transmit(gs_fd, tx, rx, len);
 }
 
+/**
+ * @brief         interface spi bus transmit vector
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          every segment is a separate chip select cycle
+ */
+uint8_t isd17xx_interface_spi_transmit_vector(isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    spi_segment_t s[ISD17XX_SPI_SEGMENT_MAX];
+    uint8_t i;
+    
+    /* check the number */
+    if (num > ISD17XX_SPI_SEGMENT_MAX)
+    {
+        return 1;
+    }
+    
+    /* copy the segments */
+    for (i = 0; i < num; i++)
+    {
+        s[i].tx = seg[i].tx;
+        s[i].rx = seg[i].rx;
+        s[i].len = seg[i].len;
+    }
+    
+    return spi_transmit_vector(gs_fd, s, num);
+}
+
 /**
  * @brief  interface gpio reset init
  * @return status code
@@ -162,7 +195,45 @@ uint8_t isd17xx_interface_gpio_reset_write(uint8_t value)
  */
 void isd17xx_interface_delay_ms(uint32_t ms)
 {
-    usleep(1000 * ms);
+    isd17xx_interface_delay_us(1000 * ms);
+}
+
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      optional, the driver only uses it together with get_time_us
+ */
+void isd17xx_interface_delay_us(uint32_t us)
+{
+    struct timespec ts;
+    
+    /* sleep to an absolute deadline, so a signal does not stretch the delay */
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += us / 1000000;
+    ts.tv_nsec += (long)(us % 1000000) * 1000;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+        /* resume the same deadline */
+    }
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t isd17xx_interface_get_time_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
 }
 
 /**
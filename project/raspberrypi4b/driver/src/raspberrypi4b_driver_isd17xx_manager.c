@@ -0,0 +1,836 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_manager.c
+ * @brief     raspberrypi4b driver isd17xx manager source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_manager.h"
+#include "spi.h"
+#include <gpiod.h>
+#include <poll.h>
+#include <pthread.h>
+
+/**
+ * @brief gpio device name definition
+ */
+#define GPIO_DEVICE_NAME "/dev/gpiochip0"        /**< gpio device name */
+
+/**
+ * @brief isd17xx manager device structure definition
+ */
+typedef struct isd17xx_manager_device_s
+{
+    isd17xx_handle_t handle;                     /**< isd17xx handle */
+    isd17xx_manager_config_t config;             /**< device config */
+    int fd;                                      /**< spi handle */
+    struct gpiod_line *reset_line;               /**< reset gpio line handle */
+    struct gpiod_line *int_line;                 /**< int gpio line handle */
+    int int_fd;                                  /**< int event fd */
+    uint8_t bus;                                 /**< spi bus number */
+    uint8_t used;                                /**< used flag */
+} isd17xx_manager_device_t;
+
+static struct gpiod_chip *gs_chip;                                              /**< gpio chip handle */
+static isd17xx_manager_device_t gs_device[ISD17XX_MANAGER_MAX_DEVICE];          /**< device table */
+static pthread_mutex_t gs_bus_mutex[ISD17XX_MANAGER_MAX_BUS] =                  /**< spi bus lock */
+{
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+};
+
+/**
+ * @brief     device spi bus init
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_spi_init(uint8_t id)
+{
+    return spi_init(gs_device[id].config.spi_name, &gs_device[id].fd, SPI_MODE_TYPE_3, gs_device[id].config.spi_freq);
+}
+
+/**
+ * @brief     device spi bus deinit
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_spi_deinit(uint8_t id)
+{
+    return spi_deinit(gs_device[id].fd);
+}
+
+/**
+ * @brief      device spi bus read
+ * @param[in]  id device id
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_manager_spi_read(uint8_t id, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    /* hold the bus only for this frame */
+    pthread_mutex_lock(&gs_bus_mutex[gs_device[id].bus]);
+    res = spi_read(gs_device[id].fd, reg, buf, len);
+    pthread_mutex_unlock(&gs_bus_mutex[gs_device[id].bus]);
+    
+    return res;
+}
+
+/**
+ * @brief     device spi bus write
+ * @param[in] id device id
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_spi_write(uint8_t id, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    /* hold the bus only for this frame */
+    pthread_mutex_lock(&gs_bus_mutex[gs_device[id].bus]);
+    res = spi_write(gs_device[id].fd, reg, buf, len);
+    pthread_mutex_unlock(&gs_bus_mutex[gs_device[id].bus]);
+    
+    return res;
+}
+
+/**
+ * @brief      device spi bus transmit
+ * @param[in]  id device id
+ * @param[in]  *tx pointer to a tx data buffer
+ * @param[out] *rx pointer to a rx data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transmit failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_manager_spi_transmit(uint8_t id, uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    uint8_t res;
+    
+    /* hold the bus only for this frame */
+    pthread_mutex_lock(&gs_bus_mutex[gs_device[id].bus]);
+    res = spi_transmit(gs_device[id].fd, tx, rx, len);
+    pthread_mutex_unlock(&gs_bus_mutex[gs_device[id].bus]);
+    
+    return res;
+}
+
+/**
+ * @brief         device spi bus transmit vector
+ * @param[in]     id device id
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          none
+ */
+static uint8_t a_isd17xx_manager_spi_transmit_vector(uint8_t id, isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    spi_segment_t s[ISD17XX_SPI_SEGMENT_MAX];
+    uint8_t res;
+    uint8_t i;
+    
+    /* check the number */
+    if (num > ISD17XX_SPI_SEGMENT_MAX)
+    {
+        return 1;
+    }
+    
+    /* copy the segments */
+    for (i = 0; i < num; i++)
+    {
+        s[i].tx = seg[i].tx;
+        s[i].rx = seg[i].rx;
+        s[i].len = seg[i].len;
+    }
+    
+    /* hold the bus for the whole message */
+    pthread_mutex_lock(&gs_bus_mutex[gs_device[id].bus]);
+    res = spi_transmit_vector(gs_device[id].fd, s, num);
+    pthread_mutex_unlock(&gs_bus_mutex[gs_device[id].bus]);
+    
+    return res;
+}
+
+/**
+ * @brief     device gpio reset init
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio reset init failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_gpio_reset_init(uint8_t id)
+{
+    /* no reset line */
+    if (gs_device[id].config.reset_line < 0)
+    {
+        return 0;
+    }
+    
+    /* get the gpio line */
+    gs_device[id].reset_line = gpiod_chip_get_line(gs_chip, (unsigned int)gs_device[id].config.reset_line);
+    if (gs_device[id].reset_line == NULL)
+    {
+        perror("gpio: get line failed.\n");
+        
+        return 1;
+    }
+    
+    /* set output high */
+    if (gpiod_line_request_output(gs_device[id].reset_line, "isd17xx_reset", 1) != 0)
+    {
+        perror("gpio: request output failed.\n");
+        gs_device[id].reset_line = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     device gpio reset deinit
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_gpio_reset_deinit(uint8_t id)
+{
+    /* release the line */
+    if (gs_device[id].reset_line != NULL)
+    {
+        gpiod_line_release(gs_device[id].reset_line);
+        gs_device[id].reset_line = NULL;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     device gpio reset write
+ * @param[in] id device id
+ * @param[in] value written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio reset write failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_manager_gpio_reset_write(uint8_t id, uint8_t value)
+{
+    /* no reset line */
+    if (gs_device[id].reset_line == NULL)
+    {
+        return 0;
+    }
+    
+    /* set the value */
+    if (gpiod_line_set_value(gs_device[id].reset_line, value) < 0)
+    {
+        perror("gpio: set value failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief isd17xx manager link function definition
+ * @note  the handle links carry no context, so every device gets its own set
+ */
+#define ISD17XX_MANAGER_LINK(N)                                                                                      \
+static uint8_t a_isd17xx_manager_spi_init_##N(void)                                                                  \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_init(N);                                                                            \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_spi_deinit_##N(void)                                                                \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_deinit(N);                                                                          \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_spi_read_##N(uint8_t reg, uint8_t *buf, uint16_t len)                               \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_read(N, reg, buf, len);                                                             \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_spi_write_##N(uint8_t reg, uint8_t *buf, uint16_t len)                              \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_write(N, reg, buf, len);                                                            \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_spi_transmit_##N(uint8_t *tx, uint8_t *rx, uint16_t len)                            \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_transmit(N, tx, rx, len);                                                           \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_spi_transmit_vector_##N(isd17xx_spi_segment_t *seg, uint8_t num)                    \
+{                                                                                                                    \
+    return a_isd17xx_manager_spi_transmit_vector(N, seg, num);                                                       \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_gpio_reset_init_##N(void)                                                           \
+{                                                                                                                    \
+    return a_isd17xx_manager_gpio_reset_init(N);                                                                     \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_gpio_reset_deinit_##N(void)                                                         \
+{                                                                                                                    \
+    return a_isd17xx_manager_gpio_reset_deinit(N);                                                                   \
+}                                                                                                                    \
+static uint8_t a_isd17xx_manager_gpio_reset_write_##N(uint8_t value)                                                 \
+{                                                                                                                    \
+    return a_isd17xx_manager_gpio_reset_write(N, value);                                                             \
+}                                                                                                                    \
+static void a_isd17xx_manager_link_##N(isd17xx_handle_t *handle)                                                     \
+{                                                                                                                    \
+    DRIVER_ISD17XX_LINK_SPI_INIT(handle, a_isd17xx_manager_spi_init_##N);                                            \
+    DRIVER_ISD17XX_LINK_SPI_DEINIT(handle, a_isd17xx_manager_spi_deinit_##N);                                        \
+    DRIVER_ISD17XX_LINK_SPI_READ(handle, a_isd17xx_manager_spi_read_##N);                                            \
+    DRIVER_ISD17XX_LINK_SPI_WRITE(handle, a_isd17xx_manager_spi_write_##N);                                          \
+    DRIVER_ISD17XX_LINK_SPI_TRANSMIT(handle, a_isd17xx_manager_spi_transmit_##N);                                    \
+    DRIVER_ISD17XX_LINK_SPI_TRANSMIT_VECTOR(handle, a_isd17xx_manager_spi_transmit_vector_##N);                      \
+    DRIVER_ISD17XX_LINK_GPIO_RESET_INIT(handle, a_isd17xx_manager_gpio_reset_init_##N);                              \
+    DRIVER_ISD17XX_LINK_GPIO_RESET_DEINIT(handle, a_isd17xx_manager_gpio_reset_deinit_##N);                          \
+    DRIVER_ISD17XX_LINK_GPIO_RESET_WRITE(handle, a_isd17xx_manager_gpio_reset_write_##N);                            \
+}
+
+ISD17XX_MANAGER_LINK(0)
+ISD17XX_MANAGER_LINK(1)
+ISD17XX_MANAGER_LINK(2)
+ISD17XX_MANAGER_LINK(3)
+ISD17XX_MANAGER_LINK(4)
+ISD17XX_MANAGER_LINK(5)
+ISD17XX_MANAGER_LINK(6)
+ISD17XX_MANAGER_LINK(7)
+
+/**
+ * @brief link function table definition
+ */
+static void (*const gsc_link[ISD17XX_MANAGER_MAX_DEVICE])(isd17xx_handle_t *handle) =
+{
+    a_isd17xx_manager_link_0, a_isd17xx_manager_link_1, a_isd17xx_manager_link_2, a_isd17xx_manager_link_3,
+    a_isd17xx_manager_link_4, a_isd17xx_manager_link_5, a_isd17xx_manager_link_6, a_isd17xx_manager_link_7,
+};
+
+/**
+ * @brief      check whether a device is idle
+ * @param[in]  id device id
+ * @param[out] *idle pointer to an idle flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_manager_idle(uint8_t id, uint8_t *idle)
+{
+    uint8_t status2;
+    uint16_t status1;
+    
+    /* get the status */
+    if (isd17xx_get_status(&gs_device[id].handle, &status1, &status2) != 0)
+    {
+        return 1;
+    }
+    
+    /* ready and not busy */
+    *idle = (((status2 & ISD17XX_STATUS2_RDY) != 0) &&
+             ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) == 0)) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     release the int line of a device
+ * @param[in] id device id
+ * @note      none
+ */
+static void a_isd17xx_manager_release_int(uint8_t id)
+{
+    if (gs_device[id].int_line != NULL)
+    {
+        gpiod_line_release(gs_device[id].int_line);
+        gs_device[id].int_line = NULL;
+        gs_device[id].int_fd = -1;
+    }
+}
+
+/**
+ * @brief  manager init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   none
+ */
+uint8_t isd17xx_manager_init(void)
+{
+    /* clear the table */
+    memset(gs_device, 0, sizeof(gs_device));
+    
+    /* open the gpio group */
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  manager deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all devices are removed
+ */
+uint8_t isd17xx_manager_deinit(void)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    /* remove all devices */
+    res = 0;
+    for (i = 0; i < ISD17XX_MANAGER_MAX_DEVICE; i++)
+    {
+        if (gs_device[i].used != 0)
+        {
+            if (isd17xx_manager_remove(i) != 0)
+            {
+                res = 1;
+            }
+        }
+    }
+    
+    /* close the gpio group */
+    if (gs_chip != NULL)
+    {
+        gpiod_chip_close(gs_chip);
+        gs_chip = NULL;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     add a device
+ * @param[in] id device id
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ *            - 4 id is invalid or used, or spi name is invalid
+ * @note      the chip is initialized and powered up, commands on it
+ *            do not sleep and isd17xx_manager_wait collects the results
+ */
+uint8_t isd17xx_manager_add(uint8_t id, const isd17xx_manager_config_t *config)
+{
+    unsigned int bus;
+    unsigned int cs;
+    isd17xx_manager_device_t *device;
+    
+    /* check the id */
+    if ((id >= ISD17XX_MANAGER_MAX_DEVICE) || (gs_device[id].used != 0) || (gs_chip == NULL))
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid or used.\n");
+        
+        return 4;
+    }
+    device = &gs_device[id];
+    memset(device, 0, sizeof(isd17xx_manager_device_t));
+    device->config = *config;
+    device->int_fd = -1;
+    
+    /* get the bus from /dev/spidevB.C */
+    if ((sscanf(config->spi_name, "/dev/spidev%u.%u", &bus, &cs) != 2) || (bus >= ISD17XX_MANAGER_MAX_BUS))
+    {
+        isd17xx_interface_debug_print("isd17xx: spi name is invalid.\n");
+        
+        return 4;
+    }
+    device->bus = (uint8_t)bus;
+    
+    /* link the device functions */
+    DRIVER_ISD17XX_LINK_INIT(&device->handle, isd17xx_handle_t);
+    gsc_link[id](&device->handle);
+    DRIVER_ISD17XX_LINK_DELAY_MS(&device->handle, isd17xx_interface_delay_ms);
+    DRIVER_ISD17XX_LINK_DELAY_US(&device->handle, isd17xx_interface_delay_us);
+    DRIVER_ISD17XX_LINK_GET_TIME_US(&device->handle, isd17xx_interface_get_time_us);
+    DRIVER_ISD17XX_LINK_DEBUG_PRINT(&device->handle, isd17xx_interface_debug_print);
+    DRIVER_ISD17XX_LINK_RECEIVE_CALLBACK(&device->handle, isd17xx_interface_receive_callback);
+    
+    /* request the int line */
+    if (config->int_line >= 0)
+    {
+        device->int_line = gpiod_chip_get_line(gs_chip, (unsigned int)config->int_line);
+        if (device->int_line == NULL)
+        {
+            perror("gpio: get line failed.\n");
+            
+            return 1;
+        }
+        if (gpiod_line_request_falling_edge_events(device->int_line, "isd17xx_int") != 0)
+        {
+            perror("gpio: request events failed.\n");
+            device->int_line = NULL;
+            
+            return 1;
+        }
+        device->int_fd = gpiod_line_event_get_fd(device->int_line);
+    }
+    
+    /* init the chip */
+    if ((isd17xx_set_type(&device->handle, config->type) != 0) || (isd17xx_init(&device->handle) != 0))
+    {
+        a_isd17xx_manager_release_int(id);
+        
+        return 1;
+    }
+    if (isd17xx_power_up(&device->handle) != 0)
+    {
+        (void)isd17xx_deinit(&device->handle);
+        a_isd17xx_manager_release_int(id);
+        
+        return 1;
+    }
+    
+    /* commands return at once, the manager waits for all devices together */
+    (void)isd17xx_set_command_delay(&device->handle, 0);
+    device->used = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     remove a device
+ * @param[in] id device id
+ * @return    status code
+ *            - 0 success
+ *            - 1 remove failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_remove(uint8_t id)
+{
+    uint8_t res;
+    
+    /* check the id */
+    if ((id >= ISD17XX_MANAGER_MAX_DEVICE) || (gs_device[id].used == 0))
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid.\n");
+        
+        return 4;
+    }
+    
+    /* power down and close */
+    res = 0;
+    if (isd17xx_power_down(&gs_device[id].handle) != 0)
+    {
+        res = 1;
+    }
+    if (isd17xx_deinit(&gs_device[id].handle) != 0)
+    {
+        res = 1;
+    }
+    
+    /* release the int line */
+    a_isd17xx_manager_release_int(id);
+    gs_device[id].used = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     get a device handle
+ * @param[in] id device id
+ * @return    pointer to an isd17xx handle structure, NULL if the id is invalid
+ * @note      none
+ */
+isd17xx_handle_t *isd17xx_manager_get_handle(uint8_t id)
+{
+    /* check the id */
+    if ((id >= ISD17XX_MANAGER_MAX_DEVICE) || (gs_device[id].used == 0))
+    {
+        return NULL;
+    }
+    
+    return &gs_device[id].handle;
+}
+
+/**
+ * @brief      get the spi bus of a device
+ * @param[in]  id device id
+ * @param[out] *bus pointer to a bus number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 id is invalid
+ * @note       devices on the same bus share one bus lock
+ */
+uint8_t isd17xx_manager_get_bus(uint8_t id, uint8_t *bus)
+{
+    /* check the id */
+    if ((id >= ISD17XX_MANAGER_MAX_DEVICE) || (gs_device[id].used == 0))
+    {
+        return 4;
+    }
+    *bus = gs_device[id].bus;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the int line event fd of a device
+ * @param[in]  id device id
+ * @param[out] *fd pointer to a fd buffer, -1 means the device is polled
+ * @return     status code
+ *             - 0 success
+ *             - 4 id is invalid
+ * @note       the fd stays owned by the manager, e.g. for isd17xx_reactor_add
+ */
+uint8_t isd17xx_manager_get_int_fd(uint8_t id, int *fd)
+{
+    /* check the id */
+    if ((id >= ISD17XX_MANAGER_MAX_DEVICE) || (gs_device[id].used == 0))
+    {
+        return 4;
+    }
+    *fd = gs_device[id].int_fd;
+    
+    return 0;
+}
+
+/**
+ * @brief     start playing on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_play(uint8_t id, uint16_t start_addr, uint16_t end_addr)
+{
+    isd17xx_handle_t *handle;
+    
+    /* get the handle */
+    handle = isd17xx_manager_get_handle(id);
+    if (handle == NULL)
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid.\n");
+        
+        return 4;
+    }
+    
+    return (isd17xx_set_play(handle, start_addr, end_addr) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     start recording on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_record(uint8_t id, uint16_t start_addr, uint16_t end_addr)
+{
+    isd17xx_handle_t *handle;
+    
+    /* get the handle */
+    handle = isd17xx_manager_get_handle(id);
+    if (handle == NULL)
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid.\n");
+        
+        return 4;
+    }
+    
+    return (isd17xx_set_record(handle, start_addr, end_addr) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     start erasing on a device
+ * @param[in] id device id
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_manager_erase(uint8_t id, uint16_t start_addr, uint16_t end_addr)
+{
+    isd17xx_handle_t *handle;
+    
+    /* get the handle */
+    handle = isd17xx_manager_get_handle(id);
+    if (handle == NULL)
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid.\n");
+        
+        return 4;
+    }
+    
+    return (isd17xx_set_erase(handle, start_addr, end_addr) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      wait until devices are idle
+ * @param[in]  mask device id bit mask
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *done pointer to an idle device bit mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 5 timeout
+ * @note       devices with an int line are waited on together with poll(),
+ *             the others are polled every ISD17XX_MANAGER_POLL_MS
+ */
+uint8_t isd17xx_manager_wait(uint32_t mask, uint32_t timeout_ms, uint32_t *done)
+{
+    uint8_t i;
+    uint8_t idle;
+    uint8_t polling;
+    int n;
+    int wait_ms;
+    uint32_t pending;
+    uint64_t deadline;
+    uint64_t now;
+    struct pollfd fds[ISD17XX_MANAGER_MAX_DEVICE];
+    uint8_t ids[ISD17XX_MANAGER_MAX_DEVICE];
+    struct gpiod_line_event event;
+    
+    /* only the added devices */
+    pending = 0;
+    for (i = 0; i < ISD17XX_MANAGER_MAX_DEVICE; i++)
+    {
+        if (((mask & (1U << i)) != 0) && (gs_device[i].used != 0))
+        {
+            pending |= 1U << i;
+        }
+    }
+    *done = 0;
+    deadline = isd17xx_interface_get_time_us() + (uint64_t)timeout_ms * 1000;
+    
+    while (1)
+    {
+        /* check every pending device once */
+        n = 0;
+        polling = 0;
+        for (i = 0; i < ISD17XX_MANAGER_MAX_DEVICE; i++)
+        {
+            if ((pending & (1U << i)) == 0)
+            {
+                continue;
+            }
+            if (a_isd17xx_manager_idle(i, &idle) != 0)
+            {
+                return 1;
+            }
+            if (idle != 0)
+            {
+                pending &= ~(1U << i);
+                *done |= 1U << i;
+                
+                continue;
+            }
+            if (gs_device[i].int_fd >= 0)
+            {
+                fds[n].fd = gs_device[i].int_fd;
+                fds[n].events = POLLIN | POLLPRI;
+                fds[n].revents = 0;
+                ids[n] = i;
+                n++;
+            }
+            else
+            {
+                polling = 1;
+            }
+        }
+        if (pending == 0)
+        {
+            return 0;
+        }
+        
+        /* check the timeout */
+        now = isd17xx_interface_get_time_us();
+        if (now >= deadline)
+        {
+            isd17xx_interface_debug_print("isd17xx: wait timeout.\n");
+            
+            return 5;
+        }
+        wait_ms = (int)((deadline - now + 999) / 1000);
+        if ((polling != 0) && (wait_ms > ISD17XX_MANAGER_POLL_MS))
+        {
+            wait_ms = ISD17XX_MANAGER_POLL_MS;
+        }
+        
+        /* sleep until any chip interrupts */
+        if (poll(fds, n, wait_ms) < 0)
+        {
+            perror("isd17xx: poll failed.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < n; i++)
+        {
+            if (fds[i].revents != 0)
+            {
+                (void)gpiod_line_event_read(gs_device[ids[i]].int_line, &event);
+            }
+        }
+    }
+}
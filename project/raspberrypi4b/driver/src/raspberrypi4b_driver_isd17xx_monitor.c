@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_monitor.c
+ * @brief     raspberrypi4b driver isd17xx monitor source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_monitor.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static isd17xx_monitor_sample_t gs_ring[ISD17XX_MONITOR_MAX_SAMPLE];        /**< sample ring */
+static uint32_t gs_head;                                                    /**< ring head, written by the sampler */
+static uint32_t gs_tail;                                                    /**< ring tail, written by the writer */
+static uint8_t gs_done;                                                     /**< sampler finished flag */
+static volatile sig_atomic_t gs_stop;                                       /**< stop flag */
+static FILE *gs_fp;                                                         /**< output file */
+static isd17xx_monitor_format_t gs_format;                                  /**< output format */
+
+/**
+ * @brief     signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_isd17xx_monitor_signal(int sig)
+{
+    (void)sig;
+    gs_stop = 1;
+}
+
+/**
+ * @brief     sleep until an absolute monotonic time
+ * @param[in] deadline_us deadline in us
+ * @note      returns early on a signal
+ */
+static void a_isd17xx_monitor_sleep_until(uint64_t deadline_us)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = (time_t)(deadline_us / 1000000ULL);
+    ts.tv_nsec = (long)((deadline_us % 1000000ULL) * 1000ULL);
+    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+/**
+ * @brief     write one sample
+ * @param[in] *sample pointer to a sample structure
+ * @note      only the writer thread touches the output file
+ */
+static void a_isd17xx_monitor_write(const isd17xx_monitor_sample_t *sample)
+{
+    if (gs_format == ISD17XX_MONITOR_FORMAT_BINARY)
+    {
+        (void)fwrite(sample, sizeof(isd17xx_monitor_sample_t), 1, gs_fp);
+    }
+    else
+    {
+        (void)fprintf(gs_fp, "%llu,%u,0x%04X,0x%02X,0x%04X,0x%04X,%u,%u\n",
+                      (unsigned long long)sample->time_us, sample->index, sample->status1, sample->status2,
+                      sample->play_point, sample->record_point, sample->res, sample->read_us);
+    }
+}
+
+/**
+ * @brief     writer thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      drains the ring until the sampler is done and the ring is empty
+ */
+static void *a_isd17xx_monitor_writer(void *arg)
+{
+    uint8_t done;
+    uint32_t head;
+    uint32_t tail;
+    
+    (void)arg;
+    tail = gs_tail;
+    while (1)
+    {
+        /* read the done flag first, so a sample pushed before it is never lost */
+        done = __atomic_load_n(&gs_done, __ATOMIC_ACQUIRE);
+        head = __atomic_load_n(&gs_head, __ATOMIC_ACQUIRE);
+        if (head == tail)
+        {
+            if (done != 0)
+            {
+                break;
+            }
+            (void)fflush(gs_fp);
+            isd17xx_interface_delay_ms(1);
+            
+            continue;
+        }
+        
+        /* write all the queued samples */
+        while (tail != head)
+        {
+            a_isd17xx_monitor_write(&gs_ring[tail & (ISD17XX_MONITOR_MAX_SAMPLE - 1)]);
+            tail++;
+        }
+        __atomic_store_n(&gs_tail, tail, __ATOMIC_RELEASE);
+    }
+    (void)fflush(gs_fp);
+    
+    return NULL;
+}
+
+/**
+ * @brief      run the monitor
+ * @param[in]  type chip type
+ * @param[in]  *config pointer to a config structure
+ * @param[out] *report pointer to a report structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ * @note       samples are taken on absolute deadlines and handed to a writer
+ *             thread through a ring, so the output never slows the sampling,
+ *             the chip is reset and powered up by the init and powered down by the deinit,
+ *             so a play, record or erase running before the call is not observed
+ */
+uint8_t isd17xx_monitor_run(isd17xx_type_t type, const isd17xx_monitor_config_t *config,
+                            isd17xx_monitor_report_t *report)
+{
+    uint8_t res;
+    uint32_t index;
+    uint32_t head;
+    uint32_t skip;
+    uint64_t period_us;
+    uint64_t duration_us;
+    uint64_t begin;
+    uint64_t next;
+    uint64_t now;
+    pthread_t thread;
+    struct sigaction action;
+    isd17xx_snapshot_t snapshot;
+    isd17xx_monitor_sample_t sample;
+    
+    /* check the args */
+    if ((config == NULL) || (report == NULL))
+    {
+        return 2;
+    }
+    memset(report, 0, sizeof(isd17xx_monitor_report_t));
+    
+    /* open the output with a large buffer */
+    if (config->path != NULL)
+    {
+        gs_fp = fopen(config->path, (config->format == ISD17XX_MONITOR_FORMAT_BINARY) ? "wb" : "w");
+        if (gs_fp == NULL)
+        {
+            perror("isd17xx: open output failed.\n");
+            
+            return 1;
+        }
+    }
+    else
+    {
+        gs_fp = stdout;
+    }
+    (void)setvbuf(gs_fp, NULL, _IOFBF, ISD17XX_MONITOR_WRITE_BUFFER);
+    gs_format = config->format;
+    
+    /* init the chip, the snapshot needs no command delay */
+    if (isd17xx_basic_init(type) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: basic init failed.\n");
+        if (gs_fp != stdout)
+        {
+            (void)fclose(gs_fp);
+        }
+        
+        return 1;
+    }
+    (void)isd17xx_basic_set_command_delay(0);
+    
+    /* stop on SIGINT and SIGTERM */
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = a_isd17xx_monitor_signal;
+    (void)sigemptyset(&action.sa_mask);
+    (void)sigaction(SIGINT, &action, NULL);
+    (void)sigaction(SIGTERM, &action, NULL);
+    gs_stop = 0;
+    gs_head = 0;
+    gs_tail = 0;
+    gs_done = 0;
+    
+    /* start the writer */
+    if (gs_format == ISD17XX_MONITOR_FORMAT_CSV)
+    {
+        (void)fprintf(gs_fp, "time_us,index,status1,status2,play_point,record_point,res,read_us\n");
+    }
+    if (pthread_create(&thread, NULL, a_isd17xx_monitor_writer, NULL) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: create writer failed.\n");
+        (void)isd17xx_basic_deinit();
+        if (gs_fp != stdout)
+        {
+            (void)fclose(gs_fp);
+        }
+        
+        return 1;
+    }
+    
+    /* sample on absolute deadlines, a late sample skips the passed ones */
+    period_us = (config->rate_hz != 0) ? (1000000ULL / config->rate_hz) : 0;
+    duration_us = (uint64_t)config->duration_ms * 1000ULL;
+    begin = isd17xx_interface_get_time_us();
+    next = begin;
+    index = 0;
+    head = 0;
+    while (gs_stop == 0)
+    {
+        now = isd17xx_interface_get_time_us();
+        if ((duration_us != 0) && ((((period_us != 0) ? next : now) - begin) >= duration_us))
+        {
+            break;
+        }
+        if (period_us != 0)
+        {
+            if (now < next)
+            {
+                a_isd17xx_monitor_sleep_until(next);
+                if (gs_stop != 0)
+                {
+                    break;
+                }
+                now = isd17xx_interface_get_time_us();
+            }
+            if (now >= next + period_us)
+            {
+                skip = (uint32_t)((now - next) / period_us);
+                report->missed_count += skip;
+                index += skip;
+                next += (uint64_t)skip * period_us;
+            }
+            if ((now > next) && ((uint32_t)(now - next) > report->max_late_us))
+            {
+                report->max_late_us = (uint32_t)(now - next);
+            }
+        }
+        
+        /* read */
+        memset(&sample, 0, sizeof(sample));
+        sample.index = index;
+        sample.time_us = isd17xx_interface_get_time_us();
+        sample.res = isd17xx_basic_snapshot(&snapshot);
+        sample.read_us = (uint32_t)(isd17xx_interface_get_time_us() - sample.time_us);
+        if (sample.res == 0)
+        {
+            sample.status1 = snapshot.status1;
+            sample.status2 = snapshot.status2;
+            sample.play_point = snapshot.play_point;
+            sample.record_point = snapshot.record_point;
+        }
+        else
+        {
+            report->error_count++;
+        }
+        if (sample.read_us > report->max_read_us)
+        {
+            report->max_read_us = sample.read_us;
+        }
+        
+        /* hand it to the writer, never wait for it */
+        if ((head - __atomic_load_n(&gs_tail, __ATOMIC_ACQUIRE)) >= ISD17XX_MONITOR_MAX_SAMPLE)
+        {
+            report->dropped_count++;
+        }
+        else
+        {
+            gs_ring[head & (ISD17XX_MONITOR_MAX_SAMPLE - 1)] = sample;
+            head++;
+            __atomic_store_n(&gs_head, head, __ATOMIC_RELEASE);
+            report->sample_count++;
+        }
+        index++;
+        next += period_us;
+    }
+    report->wall_us = isd17xx_interface_get_time_us() - begin;
+    
+    /* let the writer drain the ring */
+    __atomic_store_n(&gs_done, 1, __ATOMIC_RELEASE);
+    (void)pthread_join(thread, NULL);
+    (void)isd17xx_basic_deinit();
+    res = 0;
+    if (ferror(gs_fp) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: write output failed.\n");
+        res = 1;
+    }
+    if ((gs_fp != stdout) && (fclose(gs_fp) != 0))
+    {
+        perror("isd17xx: close output failed.\n");
+        res = 1;
+    }
+    gs_fp = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief     print a monitor report
+ * @param[in] *report pointer to a report structure
+ * @note      printed to stderr, stdout may carry the samples
+ */
+void isd17xx_monitor_print_report(const isd17xx_monitor_report_t *report)
+{
+    (void)fprintf(stderr, "isd17xx: %u samples in %.1f ms, %.1f samples/s.\n", report->sample_count,
+                  (double)report->wall_us / 1000.0,
+                  (report->wall_us != 0) ? (double)report->sample_count * 1000000.0 / (double)report->wall_us : 0.0);
+    (void)fprintf(stderr, "isd17xx: %u missed, %u dropped, %u read errors.\n", report->missed_count,
+                  report->dropped_count, report->error_count);
+    (void)fprintf(stderr, "isd17xx: max late %u us, max read %u us.\n", report->max_late_us, report->max_read_us);
+}
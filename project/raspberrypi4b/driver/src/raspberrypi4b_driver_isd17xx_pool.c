@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_pool.c
+ * @brief     raspberrypi4b driver isd17xx pool source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_pool.h"
+#include <pthread.h>
+
+/**
+ * @brief isd17xx pool queue structure definition
+ */
+typedef struct isd17xx_pool_queue_s
+{
+    isd17xx_pool_task_t task[ISD17XX_POOL_MAX_TASK];        /**< task ring */
+    uint8_t head;                                           /**< ring head */
+    uint8_t len;                                            /**< ring length */
+    uint8_t running;                                        /**< head task is running */
+    uint8_t busy_seen;                                      /**< chip was seen busy */
+    uint8_t stopping;                                       /**< stop was sent */
+    uint64_t start_us;                                      /**< head task start time */
+} isd17xx_pool_queue_t;
+
+/**
+ * @brief isd17xx pool worker structure definition
+ */
+typedef struct isd17xx_pool_worker_s
+{
+    pthread_t thread;                  /**< worker thread */
+    uint8_t bus;                       /**< spi bus number */
+    uint8_t timeout;                   /**< timeout flag */
+    uint64_t deadline_us;              /**< deadline */
+    uint32_t task_count;               /**< finished task number */
+    uint32_t failed_count;             /**< failed task number */
+    uint64_t serial_us;                /**< sum of task times */
+} isd17xx_pool_worker_t;
+
+static isd17xx_pool_queue_t gs_queue[ISD17XX_MANAGER_MAX_DEVICE];        /**< device task queues */
+
+/**
+ * @brief     start the head task of a device
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *task pointer to a task structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the manager handles have no command delay, so this returns at once
+ */
+static uint8_t a_isd17xx_pool_start(isd17xx_handle_t *handle, const isd17xx_pool_task_t *task)
+{
+    switch (task->type)
+    {
+        case ISD17XX_POOL_TASK_GLOBAL_ERASE :
+        {
+            return (isd17xx_global_erase(handle) != 0) ? 1 : 0;
+        }
+        case ISD17XX_POOL_TASK_ERASE :
+        {
+            return (isd17xx_set_erase(handle, task->start_addr, task->end_addr) != 0) ? 1 : 0;
+        }
+        case ISD17XX_POOL_TASK_RECORD :
+        {
+            return (isd17xx_set_record(handle, task->start_addr, task->end_addr) != 0) ? 1 : 0;
+        }
+        case ISD17XX_POOL_TASK_PLAY :
+        {
+            return (isd17xx_set_play(handle, task->start_addr, task->end_addr) != 0) ? 1 : 0;
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     step the queue of one device
+ * @param[in] *worker pointer to a worker structure
+ * @param[in] id device id
+ * @return    1 if the device still has work, otherwise 0
+ * @note      a record or play that runs out of time is stopped with one raw frame and ends on a later step
+ */
+static uint8_t a_isd17xx_pool_step(isd17xx_pool_worker_t *worker, uint8_t id)
+{
+    uint8_t done;
+    uint8_t busy;
+    uint8_t status2;
+    uint16_t status1;
+    uint64_t now;
+    uint64_t elapsed;
+    isd17xx_handle_t *handle;
+    isd17xx_pool_queue_t *queue;
+    isd17xx_pool_task_t *task;
+    
+    handle = isd17xx_manager_get_handle(id);
+    queue = &gs_queue[id];
+    
+    /* check the running task */
+    if (queue->running != 0)
+    {
+        task = &queue->task[queue->head];
+        done = 0;
+        if (isd17xx_get_status(handle, &status1, &status2) != 0)
+        {
+            worker->failed_count++;
+            done = 1;
+        }
+        else
+        {
+            now = isd17xx_interface_get_time_us();
+            elapsed = now - queue->start_us;
+            busy = (((status2 & ISD17XX_STATUS2_RDY) == 0) ||
+                    ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) != 0)) ? 1 : 0;
+            if (busy != 0)
+            {
+                queue->busy_seen = 1;
+            }
+            if ((busy == 0) && ((queue->busy_seen != 0) || (queue->stopping != 0) ||
+                                (elapsed >= (uint64_t)ISD17XX_POOL_SETTLE_MS * 1000)))
+            {
+                /* the chip finished on its own or the stop has settled */
+                done = 1;
+            }
+            else if ((queue->stopping == 0) && (task->duration_ms != 0) && (elapsed >= (uint64_t)task->duration_ms * 1000) &&
+                     ((task->type == ISD17XX_POOL_TASK_RECORD) || (task->type == ISD17XX_POOL_TASK_PLAY)))
+            {
+                /* the time is up, send one stop frame and let the next step collect it */
+                if (isd17xx_send_command(handle, ISD17XX_COMMAND_STOP, &status1) != 0)
+                {
+                    worker->failed_count++;
+                    done = 1;
+                }
+                else
+                {
+                    queue->stopping = 1;
+                    
+                    return 1;
+                }
+            }
+            else
+            {
+                return 1;
+            }
+        }
+        if (done != 0)
+        {
+            worker->serial_us += isd17xx_interface_get_time_us() - queue->start_us;
+            worker->task_count++;
+            queue->running = 0;
+            queue->head = (queue->head + 1) % ISD17XX_POOL_MAX_TASK;
+            queue->len--;
+        }
+    }
+    
+    /* start the next task */
+    while (queue->len != 0)
+    {
+        queue->start_us = isd17xx_interface_get_time_us();
+        queue->busy_seen = 0;
+        queue->stopping = 0;
+        if (a_isd17xx_pool_start(handle, &queue->task[queue->head]) == 0)
+        {
+            queue->running = 1;
+            
+            return 1;
+        }
+        worker->failed_count++;
+        queue->head = (queue->head + 1) % ISD17XX_POOL_MAX_TASK;
+        queue->len--;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg pointer to a worker structure
+ * @return    NULL
+ * @note      the worker serves every device on its bus, so erases on
+ *            different chips overlap while each spi frame takes the bus lock
+ */
+static void *a_isd17xx_pool_worker(void *arg)
+{
+    uint8_t id;
+    uint8_t bus;
+    uint8_t active;
+    isd17xx_pool_worker_t *worker = (isd17xx_pool_worker_t *)arg;
+    
+    while (1)
+    {
+        /* step all devices on this bus */
+        active = 0;
+        for (id = 0; id < ISD17XX_MANAGER_MAX_DEVICE; id++)
+        {
+            if ((isd17xx_manager_get_bus(id, &bus) != 0) || (bus != worker->bus))
+            {
+                continue;
+            }
+            if (a_isd17xx_pool_step(worker, id) != 0)
+            {
+                active = 1;
+            }
+        }
+        if (active == 0)
+        {
+            break;
+        }
+        
+        /* check the deadline */
+        if (isd17xx_interface_get_time_us() >= worker->deadline_us)
+        {
+            worker->timeout = 1;
+            
+            break;
+        }
+        isd17xx_interface_delay_ms(ISD17XX_POOL_POLL_MS);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     submit a task to a device queue
+ * @param[in] id device id
+ * @param[in] *task pointer to a task structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 id is invalid
+ *            - 5 queue is full
+ * @note      tasks of one device run in order
+ */
+uint8_t isd17xx_pool_submit(uint8_t id, const isd17xx_pool_task_t *task)
+{
+    isd17xx_pool_queue_t *queue;
+    
+    /* check the id */
+    if (isd17xx_manager_get_handle(id) == NULL)
+    {
+        isd17xx_interface_debug_print("isd17xx: id is invalid.\n");
+        
+        return 4;
+    }
+    
+    /* push the task */
+    queue = &gs_queue[id];
+    if (queue->len >= ISD17XX_POOL_MAX_TASK)
+    {
+        isd17xx_interface_debug_print("isd17xx: queue is full.\n");
+        
+        return 5;
+    }
+    queue->task[(queue->head + queue->len) % ISD17XX_POOL_MAX_TASK] = *task;
+    queue->len++;
+    
+    return 0;
+}
+
+/**
+ * @brief      run all queued tasks
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *report pointer to a report structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 5 timeout
+ * @note       one worker thread is started per spi bus, each worker keeps
+ *             all of its chips busy and the queues are empty after it returns
+ */
+uint8_t isd17xx_pool_run(uint32_t timeout_ms, isd17xx_pool_report_t *report)
+{
+    uint8_t i;
+    uint8_t id;
+    uint8_t bus;
+    uint8_t res;
+    uint8_t num;
+    uint32_t bus_mask;
+    uint64_t start;
+    isd17xx_pool_worker_t worker[ISD17XX_MANAGER_MAX_BUS];
+    
+    /* one worker per used bus */
+    memset(report, 0, sizeof(isd17xx_pool_report_t));
+    memset(worker, 0, sizeof(worker));
+    start = isd17xx_interface_get_time_us();
+    bus_mask = 0;
+    num = 0;
+    for (id = 0; id < ISD17XX_MANAGER_MAX_DEVICE; id++)
+    {
+        if ((isd17xx_manager_get_bus(id, &bus) != 0) || ((bus_mask & (1U << bus)) != 0))
+        {
+            continue;
+        }
+        bus_mask |= 1U << bus;
+        worker[num].bus = bus;
+        worker[num].deadline_us = start + (uint64_t)timeout_ms * 1000;
+        num++;
+    }
+    
+    /* start the workers */
+    res = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (pthread_create(&worker[i].thread, NULL, a_isd17xx_pool_worker, &worker[i]) != 0)
+        {
+            isd17xx_interface_debug_print("isd17xx: create worker failed.\n");
+            num = i;
+            res = 1;
+            
+            break;
+        }
+    }
+    
+    /* join the workers */
+    for (i = 0; i < num; i++)
+    {
+        (void)pthread_join(worker[i].thread, NULL);
+        report->task_count += worker[i].task_count;
+        report->failed_count += worker[i].failed_count;
+        report->serial_us += worker[i].serial_us;
+        if ((worker[i].timeout != 0) && (res == 0))
+        {
+            isd17xx_interface_debug_print("isd17xx: pool timeout.\n");
+            res = 5;
+        }
+    }
+    report->worker_count = num;
+    report->wall_us = isd17xx_interface_get_time_us() - start;
+    
+    /* drop what is left */
+    if (res != 0)
+    {
+        memset(gs_queue, 0, sizeof(gs_queue));
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     print a report
+ * @param[in] *report pointer to a report structure
+ * @note      none
+ */
+void isd17xx_pool_print_report(const isd17xx_pool_report_t *report)
+{
+    isd17xx_interface_debug_print("isd17xx: %d tasks, %d failed, %d workers.\n",
+                                  report->task_count, report->failed_count, report->worker_count);
+    isd17xx_interface_debug_print("isd17xx: wall %.1f ms, serial %.1f ms, speedup %.2fx.\n",
+                                  (double)report->wall_us / 1000.0, (double)report->serial_us / 1000.0,
+                                  (report->wall_us != 0) ? (double)report->serial_us / (double)report->wall_us : 0.0);
+}
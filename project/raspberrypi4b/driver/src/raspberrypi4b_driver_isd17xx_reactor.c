@@ -0,0 +1,642 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_reactor.c
+ * @brief     raspberrypi4b driver isd17xx reactor source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_reactor.h"
+#include <errno.h>
+#include <gpiod.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/**
+ * @brief     find a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    device index, -1 if not found
+ * @note      none
+ */
+static int a_isd17xx_reactor_find(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle)
+{
+    uint16_t i;
+    
+    for (i = 0; i < reactor->num; i++)
+    {
+        if (reactor->device[i].handle == handle)
+        {
+            return (int)i;
+        }
+    }
+    
+    return -1;
+}
+
+/**
+ * @brief     arm the timerfd to the next deadline
+ * @param[in] *reactor pointer to a reactor structure
+ * @note      the timer is only touched when the deadline changes
+ */
+static void a_isd17xx_reactor_arm(isd17xx_reactor_t *reactor)
+{
+    uint64_t deadline;
+    struct itimerspec spec;
+    
+    /* find the earliest deadline */
+    if (isd17xx_reactor_next_deadline(reactor, &deadline) != 0)
+    {
+        deadline = 0;
+    }
+    if (deadline == reactor->armed_us)
+    {
+        return;
+    }
+    
+    /* absolute monotonic time, all zero disarms */
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = (time_t)(deadline / 1000000ULL);
+    spec.it_value.tv_nsec = (long)(deadline % 1000000ULL) * 1000L;
+    if ((deadline != 0) && (spec.it_value.tv_sec == 0) && (spec.it_value.tv_nsec == 0))
+    {
+        spec.it_value.tv_nsec = 1;
+    }
+    if (timerfd_settime(reactor->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) != 0)
+    {
+        perror("isd17xx: timerfd settime failed.\n");
+        
+        return;
+    }
+    reactor->armed_us = deadline;
+}
+
+/**
+ * @brief     finish the operation of a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] i device index
+ * @param[in] result operation result
+ * @note      the device is idle before the callback runs, so the callback may submit again
+ */
+static void a_isd17xx_reactor_complete(isd17xx_reactor_t *reactor, uint16_t i, isd17xx_reactor_result_t result)
+{
+    isd17xx_reactor_device_t *device;
+    
+    device = &reactor->device[i];
+    device->busy = 0;
+    device->stopping = 0;
+    device->poll_us = 0;
+    device->timeout_us = 0;
+    if (device->callback != NULL)
+    {
+        device->callback(device->handle, result, device->arg);
+    }
+}
+
+/**
+ * @brief     stop the operation of a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] i device index
+ * @param[in] result operation result
+ * @param[in] now current time in us
+ * @note      stop is sent as a raw frame, the next timer tick collects it and clears the interrupt it raised
+ */
+static void a_isd17xx_reactor_stop(isd17xx_reactor_t *reactor, uint16_t i, isd17xx_reactor_result_t result, uint64_t now)
+{
+    uint16_t status1;
+    isd17xx_reactor_device_t *device;
+    
+    device = &reactor->device[i];
+    if (isd17xx_send_command(device->handle, ISD17XX_COMMAND_STOP, &status1) != 0)
+    {
+        a_isd17xx_reactor_complete(reactor, i, ISD17XX_REACTOR_RESULT_FAILED);
+        
+        return;
+    }
+    device->stopping = 1;
+    device->result = result;
+    device->timeout_us = 0;
+    device->poll_us = now + (uint64_t)ISD17XX_REACTOR_POLL_MS * 1000;
+}
+
+/**
+ * @brief     service a busy device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] i device index
+ * @param[in] now current time in us
+ * @note      status1 comes back on the clear interrupt frame, so one frame checks and clears int
+ */
+static void a_isd17xx_reactor_service(isd17xx_reactor_t *reactor, uint16_t i, uint64_t now)
+{
+    uint16_t status1;
+    isd17xx_reactor_device_t *device;
+    
+    device = &reactor->device[i];
+    if (isd17xx_irq_service(device->handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, NULL) != 0)
+    {
+        a_isd17xx_reactor_complete(reactor, i, ISD17XX_REACTOR_RESULT_FAILED);
+        
+        return;
+    }
+    if (device->stopping != 0)
+    {
+        a_isd17xx_reactor_complete(reactor, i, device->result);
+        
+        return;
+    }
+    if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)
+    {
+        a_isd17xx_reactor_complete(reactor, i, ISD17XX_REACTOR_RESULT_FAILED);
+        
+        return;
+    }
+    if ((status1 & ISD17XX_STATUS1_INT) != 0)
+    {
+        a_isd17xx_reactor_complete(reactor, i, ISD17XX_REACTOR_RESULT_DONE);
+        
+        return;
+    }
+    
+    /* still running */
+    if (device->int_fd < 0)
+    {
+        device->poll_us = now + (uint64_t)ISD17XX_REACTOR_POLL_MS * 1000;
+    }
+}
+
+/**
+ * @brief     reactor init
+ * @param[in] *reactor pointer to a reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 reactor is NULL
+ * @note      none
+ */
+uint8_t isd17xx_reactor_init(isd17xx_reactor_t *reactor)
+{
+    /* check the reactor */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    
+    /* clear the table */
+    memset(reactor, 0, sizeof(isd17xx_reactor_t));
+    
+    /* the deadlines use the same clock as isd17xx_interface_get_time_us */
+    reactor->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (reactor->timer_fd < 0)
+    {
+        perror("isd17xx: timerfd create failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reactor deinit
+ * @param[in] *reactor pointer to a reactor structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ * @note      pending operations are dropped without callbacks, the chips keep running
+ */
+uint8_t isd17xx_reactor_deinit(isd17xx_reactor_t *reactor)
+{
+    /* check the reactor */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    
+    /* close the timer */
+    if (reactor->timer_fd >= 0)
+    {
+        (void)close(reactor->timer_fd);
+        reactor->timer_fd = -1;
+    }
+    reactor->num = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     add a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an initialized isd17xx handle structure
+ * @param[in] int_fd int line event fd, -1 means polling
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *arg pointer to a callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor or handle is NULL
+ *            - 4 reactor is full or handle is added
+ * @note      the int fd is a gpiod falling edge event fd, e.g. from isd17xx_manager_get_int_fd,
+ *            get_fds has to be called again after a device is added or removed
+ */
+uint8_t isd17xx_reactor_add(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle, int int_fd,
+                            void (*callback)(isd17xx_handle_t *handle, isd17xx_reactor_result_t result, void *arg),
+                            void *arg)
+{
+    isd17xx_reactor_device_t *device;
+    
+    /* check the args */
+    if ((reactor == NULL) || (handle == NULL))
+    {
+        return 2;
+    }
+    if ((reactor->num >= ISD17XX_REACTOR_MAX_DEVICE) || (a_isd17xx_reactor_find(reactor, handle) >= 0))
+    {
+        isd17xx_interface_debug_print("isd17xx: reactor is full or handle is added.\n");
+        
+        return 4;
+    }
+    
+    /* append the device */
+    device = &reactor->device[reactor->num];
+    memset(device, 0, sizeof(isd17xx_reactor_device_t));
+    device->handle = handle;
+    device->int_fd = int_fd;
+    device->callback = callback;
+    device->arg = arg;
+    reactor->num++;
+    
+    return 0;
+}
+
+/**
+ * @brief     remove a device
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ * @note      a pending operation is dropped without callback
+ */
+uint8_t isd17xx_reactor_remove(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle)
+{
+    int i;
+    
+    /* check the reactor */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    
+    /* find the device */
+    i = a_isd17xx_reactor_find(reactor, handle);
+    if (i < 0)
+    {
+        return 4;
+    }
+    
+    /* move the last device into the hole */
+    reactor->num--;
+    reactor->device[i] = reactor->device[reactor->num];
+    a_isd17xx_reactor_arm(reactor);
+    
+    return 0;
+}
+
+/**
+ * @brief     start an operation
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] op operation
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @param[in] timeout_ms timeout in ms, 0 means none
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ *            - 5 device is busy
+ *            - 6 op is invalid
+ * @note      the command is sent at once without the command delay and the callback runs from on_readable,
+ *            a stale interrupt is cleared first so it can not end the new operation
+ */
+uint8_t isd17xx_reactor_submit(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle, isd17xx_reactor_op_t op,
+                               uint16_t start_addr, uint16_t end_addr, uint32_t timeout_ms)
+{
+    int i;
+    uint8_t res;
+    uint16_t status1;
+    uint16_t command_delay;
+    uint64_t now;
+    isd17xx_reactor_device_t *device;
+    
+    /* check the args */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    i = a_isd17xx_reactor_find(reactor, handle);
+    if (i < 0)
+    {
+        return 4;
+    }
+    device = &reactor->device[i];
+    if (device->busy != 0)
+    {
+        return 5;
+    }
+    if (op > ISD17XX_REACTOR_OP_ERASE)
+    {
+        return 6;
+    }
+    
+    /* clear a stale interrupt */
+    if (isd17xx_irq_service(handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    /* send the command, completion comes from int so skip the command delay */
+    command_delay = handle->command_delay;
+    handle->command_delay = 0;
+    if (op == ISD17XX_REACTOR_OP_PLAY)
+    {
+        res = isd17xx_set_play(handle, start_addr, end_addr);
+    }
+    else if (op == ISD17XX_REACTOR_OP_RECORD)
+    {
+        res = isd17xx_set_record(handle, start_addr, end_addr);
+    }
+    else
+    {
+        res = isd17xx_set_erase(handle, start_addr, end_addr);
+    }
+    handle->command_delay = command_delay;
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* set the deadlines */
+    now = isd17xx_interface_get_time_us();
+    device->busy = 1;
+    device->poll_us = (device->int_fd < 0) ? (now + (uint64_t)ISD17XX_REACTOR_POLL_MS * 1000) : 0;
+    device->timeout_us = (timeout_ms != 0) ? (now + (uint64_t)timeout_ms * 1000) : 0;
+    a_isd17xx_reactor_arm(reactor);
+    
+    return 0;
+}
+
+/**
+ * @brief     cancel an operation
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 reactor is NULL
+ *            - 4 handle is not added
+ *            - 5 device is not busy
+ * @note      a stop frame is sent at once and the next on_readable tick runs the callback
+ *            with ISD17XX_REACTOR_RESULT_CANCELLED, the device stays busy until then
+ */
+uint8_t isd17xx_reactor_cancel(isd17xx_reactor_t *reactor, isd17xx_handle_t *handle)
+{
+    int i;
+    
+    /* check the args */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    i = a_isd17xx_reactor_find(reactor, handle);
+    if (i < 0)
+    {
+        return 4;
+    }
+    if (reactor->device[i].busy == 0)
+    {
+        return 5;
+    }
+    
+    /* stop the chip */
+    a_isd17xx_reactor_stop(reactor, (uint16_t)i, ISD17XX_REACTOR_RESULT_CANCELLED, isd17xx_interface_get_time_us());
+    a_isd17xx_reactor_arm(reactor);
+    
+    return 0;
+}
+
+/**
+ * @brief         get the pollable fds
+ * @param[in]     *reactor pointer to a reactor structure
+ * @param[out]    *fds pointer to a fd buffer
+ * @param[in,out] *num pointer to a fd number buffer, the buffer size in and the fd number out
+ * @return        status code
+ *                - 0 success
+ *                - 2 reactor is NULL
+ *                - 4 buffer is too small
+ * @note          the timerfd comes first followed by the int fds, register them all with EPOLLIN
+ */
+uint8_t isd17xx_reactor_get_fds(isd17xx_reactor_t *reactor, int *fds, uint16_t *num)
+{
+    uint16_t i;
+    uint16_t n;
+    
+    /* check the args */
+    if ((reactor == NULL) || (fds == NULL) || (num == NULL))
+    {
+        return 2;
+    }
+    if (*num == 0)
+    {
+        return 4;
+    }
+    
+    /* timer first */
+    n = 0;
+    fds[n++] = reactor->timer_fd;
+    
+    /* then every int line */
+    for (i = 0; i < reactor->num; i++)
+    {
+        if (reactor->device[i].int_fd < 0)
+        {
+            continue;
+        }
+        if (n >= *num)
+        {
+            return 4;
+        }
+        fds[n++] = reactor->device[i].int_fd;
+    }
+    *num = n;
+    
+    return 0;
+}
+
+/**
+ * @brief     handle a readable fd
+ * @param[in] *reactor pointer to a reactor structure
+ * @param[in] fd readable fd
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 reactor is NULL
+ *            - 4 fd is unknown
+ * @note      a timer tick polls devices without int line, stops timed out operations and collects the stops,
+ *            an int event services its device with one clear interrupt frame
+ */
+uint8_t isd17xx_reactor_on_readable(isd17xx_reactor_t *reactor, int fd)
+{
+    uint16_t i;
+    uint64_t now;
+    uint64_t expirations;
+    struct gpiod_line_event event;
+    
+    /* check the reactor */
+    if (reactor == NULL)
+    {
+        return 2;
+    }
+    
+    if (fd == reactor->timer_fd)
+    {
+        /* consume the tick, an early call finds nothing to read */
+        if ((read(fd, &expirations, sizeof(expirations)) < 0) && (errno != EAGAIN))
+        {
+            perror("isd17xx: timerfd read failed.\n");
+            
+            return 1;
+        }
+        reactor->armed_us = 0;
+        
+        /* stop timed out operations, poll the due devices and collect the stops */
+        now = isd17xx_interface_get_time_us();
+        for (i = 0; i < reactor->num; i++)
+        {
+            if (reactor->device[i].busy == 0)
+            {
+                continue;
+            }
+            if ((reactor->device[i].timeout_us != 0) && (reactor->device[i].timeout_us <= now))
+            {
+                isd17xx_interface_debug_print("isd17xx: reactor timeout.\n");
+                a_isd17xx_reactor_stop(reactor, i, ISD17XX_REACTOR_RESULT_TIMEOUT, now);
+            }
+            else if (((reactor->device[i].int_fd < 0) || (reactor->device[i].stopping != 0)) &&
+                     (reactor->device[i].poll_us <= now))
+            {
+                a_isd17xx_reactor_service(reactor, i, now);
+            }
+            else
+            {
+                /* not due yet */
+            }
+        }
+        a_isd17xx_reactor_arm(reactor);
+        
+        return 0;
+    }
+    
+    /* an int line fired */
+    for (i = 0; i < reactor->num; i++)
+    {
+        if (reactor->device[i].int_fd == fd)
+        {
+            break;
+        }
+    }
+    if (i == reactor->num)
+    {
+        return 4;
+    }
+    if (gpiod_line_event_read_fd(fd, &event) != 0)
+    {
+        perror("isd17xx: gpio event read failed.\n");
+        
+        return 1;
+    }
+    if (reactor->device[i].busy != 0)
+    {
+        a_isd17xx_reactor_service(reactor, i, isd17xx_interface_get_time_us());
+        a_isd17xx_reactor_arm(reactor);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      get the next deadline
+ * @param[in]  *reactor pointer to a reactor structure
+ * @param[out] *deadline_us pointer to a monotonic deadline buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 reactor is NULL
+ *             - 4 no deadline
+ * @note       for loops that prefer an epoll_wait timeout to the timerfd, call
+ *             on_readable with the timerfd once the deadline has passed
+ */
+uint8_t isd17xx_reactor_next_deadline(isd17xx_reactor_t *reactor, uint64_t *deadline_us)
+{
+    uint16_t i;
+    uint64_t deadline;
+    
+    /* check the args */
+    if ((reactor == NULL) || (deadline_us == NULL))
+    {
+        return 2;
+    }
+    
+    /* earliest poll time or timeout of the busy devices */
+    deadline = UINT64_MAX;
+    for (i = 0; i < reactor->num; i++)
+    {
+        if (reactor->device[i].busy == 0)
+        {
+            continue;
+        }
+        if ((reactor->device[i].poll_us != 0) && (reactor->device[i].poll_us < deadline))
+        {
+            deadline = reactor->device[i].poll_us;
+        }
+        if ((reactor->device[i].timeout_us != 0) && (reactor->device[i].timeout_us < deadline))
+        {
+            deadline = reactor->device[i].timeout_us;
+        }
+    }
+    if (deadline == UINT64_MAX)
+    {
+        return 4;
+    }
+    *deadline_us = deadline;
+    
+    return 0;
+}
@@ -0,0 +1,524 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_script.c
+ * @brief     raspberrypi4b driver isd17xx script source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_script.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief isd17xx script op name table
+ */
+static const char *const gsc_isd17xx_script_op[] =
+{
+    "erase",               /**< ISD17XX_SCRIPT_OP_ERASE */
+    "record",              /**< ISD17XX_SCRIPT_OP_RECORD */
+    "play",                /**< ISD17XX_SCRIPT_OP_PLAY */
+    "global-erase",        /**< ISD17XX_SCRIPT_OP_GLOBAL_ERASE */
+    "stop",                /**< ISD17XX_SCRIPT_OP_STOP */
+    "wait",                /**< ISD17XX_SCRIPT_OP_WAIT */
+    "delay",               /**< ISD17XX_SCRIPT_OP_DELAY */
+    "set",                 /**< ISD17XX_SCRIPT_OP_SET */
+};
+
+/**
+ * @brief isd17xx script field name table, indexed by isd17xx_apc_field_t
+ */
+static const char *const gsc_isd17xx_script_field[] =
+{
+    "volume",                        /**< ISD17XX_APC_FIELD_VOLUME */
+    "monitor-input",                 /**< ISD17XX_APC_FIELD_MONITOR_INPUT */
+    "mix-input",                     /**< ISD17XX_APC_FIELD_MIX_INPUT */
+    "sound-effect-editing",          /**< ISD17XX_APC_FIELD_SOUND_EFFECT_EDITING */
+    "spi-ft",                        /**< ISD17XX_APC_FIELD_SPI_FT */
+    "analog-output",                 /**< ISD17XX_APC_FIELD_ANALOG_OUTPUT */
+    "pwm-speaker",                   /**< ISD17XX_APC_FIELD_PWM_SPEAKER */
+    "power-up-analog-output",        /**< ISD17XX_APC_FIELD_POWER_UP_ANALOG_OUTPUT */
+    "v-alert",                       /**< ISD17XX_APC_FIELD_V_ALERT */
+    "eom",                           /**< ISD17XX_APC_FIELD_EOM */
+};
+
+/**
+ * @brief      parse a number
+ * @param[in]  *str pointer to a string
+ * @param[in]  max max value
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       decimal or 0x hexadecimal
+ */
+static uint8_t a_isd17xx_script_number(const char *str, uint32_t max, uint32_t *value)
+{
+    char *end;
+    unsigned long v;
+    
+    if ((str == NULL) || (str[0] == '-'))
+    {
+        return 1;
+    }
+    v = strtoul(str, &end, 0);
+    if ((end == str) || (*end != '\0') || (v > max))
+    {
+        return 1;
+    }
+    *value = (uint32_t)v;
+    
+    return 0;
+}
+
+/**
+ * @brief      parse one line
+ * @param[in]  *line pointer to a line buffer
+ * @param[out] *step pointer to a step structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 line is invalid
+ *             - 2 line is empty
+ * @note       the line buffer is changed
+ */
+static uint8_t a_isd17xx_script_parse(char *line, isd17xx_script_step_t *step)
+{
+    uint8_t i;
+    uint32_t start;
+    uint32_t end;
+    char *p;
+    char *arg[4];
+    uint8_t argc;
+    
+    /* cut the comment and split */
+    p = strchr(line, '#');
+    if (p != NULL)
+    {
+        *p = '\0';
+    }
+    argc = 0;
+    p = strtok(line, " \t\r\n");
+    while ((p != NULL) && (argc < 4))
+    {
+        arg[argc++] = p;
+        p = strtok(NULL, " \t\r\n");
+    }
+    if (argc == 0)
+    {
+        return 2;
+    }
+    if (p != NULL)
+    {
+        return 1;
+    }
+    
+    /* find the op */
+    for (i = 0; i < sizeof(gsc_isd17xx_script_op) / sizeof(gsc_isd17xx_script_op[0]); i++)
+    {
+        if (strcmp(arg[0], gsc_isd17xx_script_op[i]) == 0)
+        {
+            break;
+        }
+    }
+    if (i == sizeof(gsc_isd17xx_script_op) / sizeof(gsc_isd17xx_script_op[0]))
+    {
+        return 1;
+    }
+    memset(step, 0, sizeof(isd17xx_script_step_t));
+    step->op = i;
+    
+    /* check the args */
+    switch (step->op)
+    {
+        case ISD17XX_SCRIPT_OP_ERASE :
+        case ISD17XX_SCRIPT_OP_RECORD :
+        case ISD17XX_SCRIPT_OP_PLAY :
+        {
+            if ((argc != 3) || (a_isd17xx_script_number(arg[1], 0x7FF, &start) != 0) ||
+                (a_isd17xx_script_number(arg[2], 0x7FF, &end) != 0) || (start >= end))
+            {
+                return 1;
+            }
+            step->start_addr = (uint16_t)start;
+            step->end_addr = (uint16_t)end;
+            
+            return 0;
+        }
+        case ISD17XX_SCRIPT_OP_DELAY :
+        {
+            if ((argc != 2) || (a_isd17xx_script_number(arg[1], 60000, &step->value) != 0))
+            {
+                return 1;
+            }
+            
+            return 0;
+        }
+        case ISD17XX_SCRIPT_OP_SET :
+        {
+            if (argc != 3)
+            {
+                return 1;
+            }
+            for (i = 0; i < sizeof(gsc_isd17xx_script_field) / sizeof(gsc_isd17xx_script_field[0]); i++)
+            {
+                if (strcmp(arg[1], gsc_isd17xx_script_field[i]) == 0)
+                {
+                    break;
+                }
+            }
+            if ((i == sizeof(gsc_isd17xx_script_field) / sizeof(gsc_isd17xx_script_field[0])) ||
+                (a_isd17xx_script_number(arg[2], (i == ISD17XX_APC_FIELD_VOLUME) ? 7 : 1, &step->value) != 0))
+            {
+                return 1;
+            }
+            step->field = i;
+            
+            return 0;
+        }
+        default :
+        {
+            return (argc == 1) ? 0 : 1;
+        }
+    }
+}
+
+/**
+ * @brief      wait until the chip accepts the next command
+ * @param[in]  queue 1 if a play may be queued behind the running play
+ * @param[out] *queued pointer to a queued flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ * @note       polls every ISD17XX_SCRIPT_POLL_MS
+ */
+static uint8_t a_isd17xx_script_wait(uint8_t queue, uint8_t *queued)
+{
+    uint8_t status2;
+    uint16_t status1;
+    
+    *queued = 0;
+    while (1)
+    {
+        if (isd17xx_basic_status(&status1, &status2) != 0)
+        {
+            return 1;
+        }
+        if ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) == 0)
+        {
+            return 0;
+        }
+        
+        /* the chip takes a second play while playing once it is ready again */
+        if ((queue != 0) && ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_RDY)) ==
+                             (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_RDY)))
+        {
+            *queued = 1;
+            
+            return 0;
+        }
+        isd17xx_interface_delay_ms(ISD17XX_SCRIPT_POLL_MS);
+    }
+}
+
+/**
+ * @brief     send one chip step
+ * @param[in] *step pointer to a step structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_script_issue(const isd17xx_script_step_t *step)
+{
+    switch (step->op)
+    {
+        case ISD17XX_SCRIPT_OP_ERASE :
+        {
+            return isd17xx_basic_start_erase(step->start_addr, step->end_addr);
+        }
+        case ISD17XX_SCRIPT_OP_RECORD :
+        {
+            return isd17xx_basic_record(step->start_addr, step->end_addr);
+        }
+        case ISD17XX_SCRIPT_OP_PLAY :
+        {
+            return isd17xx_basic_start_play(step->start_addr, step->end_addr);
+        }
+        case ISD17XX_SCRIPT_OP_GLOBAL_ERASE :
+        {
+            return isd17xx_basic_start_global_erase();
+        }
+        case ISD17XX_SCRIPT_OP_STOP :
+        {
+            return isd17xx_basic_stop();
+        }
+        case ISD17XX_SCRIPT_OP_SET :
+        {
+            return isd17xx_basic_set_apc_field((isd17xx_apc_field_t)step->field, (uint8_t)step->value);
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief      load a script file
+ * @param[in]  *path pointer to a script path
+ * @param[out] *script pointer to a script structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 handle is NULL
+ *             - 4 a line is invalid
+ *             - 5 too many steps
+ * @note       the whole file is checked before anything is sent to the chip,
+ *             one step per line and # starts a comment
+ */
+uint8_t isd17xx_script_load(const char *path, isd17xx_script_t *script)
+{
+    uint8_t res;
+    uint16_t line;
+    FILE *fp;
+    char buf[ISD17XX_SCRIPT_MAX_LINE];
+    isd17xx_script_step_t step;
+    
+    /* check the args */
+    if ((path == NULL) || (script == NULL))
+    {
+        return 2;
+    }
+    
+    /* open the file */
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror("isd17xx: open script failed.\n");
+        
+        return 1;
+    }
+    
+    /* parse every line */
+    memset(script, 0, sizeof(isd17xx_script_t));
+    line = 0;
+    while (fgets(buf, sizeof(buf), fp) != NULL)
+    {
+        line++;
+        if ((strchr(buf, '\n') == NULL) && (feof(fp) == 0))
+        {
+            isd17xx_interface_debug_print("isd17xx: script line %d is too long.\n", line);
+            (void)fclose(fp);
+            
+            return 4;
+        }
+        res = a_isd17xx_script_parse(buf, &step);
+        if (res == 2)
+        {
+            continue;
+        }
+        if (res != 0)
+        {
+            isd17xx_interface_debug_print("isd17xx: script line %d is invalid.\n", line);
+            (void)fclose(fp);
+            
+            return 4;
+        }
+        if (script->num >= ISD17XX_SCRIPT_MAX_STEP)
+        {
+            isd17xx_interface_debug_print("isd17xx: script has more than %d steps.\n", ISD17XX_SCRIPT_MAX_STEP);
+            (void)fclose(fp);
+            
+            return 5;
+        }
+        step.line = line;
+        script->step[script->num++] = step;
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     run a loaded script in one session
+ * @param[in] type chip type
+ * @param[in] *script pointer to a script structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ * @note      the chip is initialized once, every chip step is sent as soon as
+ *            the chip accepts it and the timing of every step is printed
+ */
+uint8_t isd17xx_script_run(isd17xx_type_t type, const isd17xx_script_t *script)
+{
+    uint8_t res;
+    uint8_t queued;
+    uint8_t status2;
+    uint16_t i;
+    uint16_t status1;
+    uint64_t begin;
+    uint64_t t;
+    uint64_t wait_us;
+    uint64_t issue_us;
+    uint8_t last_op;
+    uint32_t delay_count;
+    uint32_t delay_mean;
+    uint32_t delay_max;
+    const isd17xx_script_step_t *step;
+    
+    /* check the script */
+    if (script == NULL)
+    {
+        return 2;
+    }
+    
+    /* init once, commands return at once and the script polls the status */
+    if (isd17xx_basic_init(type) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: basic init failed.\n");
+        
+        return 1;
+    }
+    if (isd17xx_basic_set_command_delay(0) != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: basic set command delay failed.\n");
+        (void)isd17xx_basic_deinit();
+        
+        return 1;
+    }
+    
+    res = 0;
+    last_op = ISD17XX_SCRIPT_OP_WAIT;
+    begin = isd17xx_interface_get_time_us();
+    for (i = 0; i < script->num; i++)
+    {
+        step = &script->step[i];
+        wait_us = 0;
+        issue_us = 0;
+        queued = 0;
+        
+        /* host steps run while the chip is still busy */
+        if (step->op == ISD17XX_SCRIPT_OP_DELAY)
+        {
+            t = isd17xx_interface_get_time_us();
+            isd17xx_interface_delay_ms(step->value);
+            isd17xx_interface_debug_print("isd17xx: line %d delay %d ms, took %llu us.\n", step->line,
+                                          step->value, (unsigned long long)(isd17xx_interface_get_time_us() - t));
+            
+            continue;
+        }
+        
+        /* wait until the chip accepts the step, stop is sent at once */
+        if (step->op != ISD17XX_SCRIPT_OP_STOP)
+        {
+            t = isd17xx_interface_get_time_us();
+            if (a_isd17xx_script_wait(((step->op == ISD17XX_SCRIPT_OP_PLAY) &&
+                                       (last_op == ISD17XX_SCRIPT_OP_PLAY)) ? 1 : 0, &queued) != 0)
+            {
+                res = 1;
+                
+                break;
+            }
+            wait_us = isd17xx_interface_get_time_us() - t;
+        }
+        if (step->op == ISD17XX_SCRIPT_OP_WAIT)
+        {
+            isd17xx_interface_debug_print("isd17xx: line %d wait, took %llu us.\n", step->line,
+                                          (unsigned long long)wait_us);
+            last_op = ISD17XX_SCRIPT_OP_WAIT;
+            
+            continue;
+        }
+        
+        /* send it */
+        t = isd17xx_interface_get_time_us();
+        if (a_isd17xx_script_issue(step) != 0)
+        {
+            res = 1;
+        }
+        else if (queued != 0)
+        {
+            /* the status read right after set play tells if the chip took it, else start it once idle */
+            if ((isd17xx_basic_status(&status1, &status2) != 0) ||
+                (((status1 & ISD17XX_STATUS1_CMD_ERR) != 0) &&
+                 ((a_isd17xx_script_wait(0, &queued) != 0) || (a_isd17xx_script_issue(step) != 0))))
+            {
+                res = 1;
+            }
+        }
+        else
+        {
+            /* nothing to do */
+        }
+        issue_us = isd17xx_interface_get_time_us() - t;
+        if (res != 0)
+        {
+            isd17xx_interface_debug_print("isd17xx: line %d %s failed.\n", step->line, gsc_isd17xx_script_op[step->op]);
+            
+            break;
+        }
+        if (step->op <= ISD17XX_SCRIPT_OP_PLAY)
+        {
+            isd17xx_interface_debug_print("isd17xx: line %d %s 0x%04X 0x%04X, wait %llu us, issue %llu us%s.\n",
+                                          step->line, gsc_isd17xx_script_op[step->op], step->start_addr, step->end_addr,
+                                          (unsigned long long)wait_us, (unsigned long long)issue_us,
+                                          (queued != 0) ? ", queued" : "");
+        }
+        else
+        {
+            isd17xx_interface_debug_print("isd17xx: line %d %s, wait %llu us, issue %llu us.\n",
+                                          step->line, gsc_isd17xx_script_op[step->op],
+                                          (unsigned long long)wait_us, (unsigned long long)issue_us);
+        }
+        last_op = step->op;
+    }
+    
+    /* leave the chip idle before the reset of deinit */
+    if (res == 0)
+    {
+        if (a_isd17xx_script_wait(0, &queued) != 0)
+        {
+            res = 1;
+        }
+        isd17xx_interface_debug_print("isd17xx: script ran %d steps in %llu us.\n", script->num,
+                                      (unsigned long long)(isd17xx_interface_get_time_us() - begin));
+        if (isd17xx_basic_delay_statistics(&delay_count, &delay_mean, &delay_max) == 0)
+        {
+            isd17xx_interface_debug_print("isd17xx: %u driver delays, overshoot mean %u us max %u us.\n",
+                                          (unsigned int)delay_count, (unsigned int)delay_mean, (unsigned int)delay_max);
+        }
+    }
+    (void)isd17xx_basic_deinit();
+    
+    return res;
+}
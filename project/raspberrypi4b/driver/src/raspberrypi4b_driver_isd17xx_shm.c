@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      raspberrypi4b_driver_isd17xx_shm.c
+ * @brief     raspberrypi4b driver isd17xx shm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "raspberrypi4b_driver_isd17xx_shm.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief     check a shm object name
+ * @param[in] *name pointer to a shm object name
+ * @return    status code
+ *            - 0 success
+ *            - 4 name is invalid
+ * @note      posix names start with one slash and fit the handle
+ */
+static uint8_t a_isd17xx_shm_name(const char *name)
+{
+    if ((name == NULL) || (name[0] != '/') || (strlen(name) >= sizeof(((isd17xx_shm_t *)0)->name)))
+    {
+        isd17xx_interface_debug_print("isd17xx: shm name is invalid.\n");
+        
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      create and map the page as the publisher
+ * @param[in]  *name pointer to a shm object name
+ * @param[in]  device_num device number
+ * @param[out] *shm pointer to a shm handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ *             - 2 handle is NULL
+ *             - 4 name or device number is invalid
+ * @note       an old page of the same name is replaced
+ */
+uint8_t isd17xx_shm_create(const char *name, uint16_t device_num, isd17xx_shm_t *shm)
+{
+    uint16_t i;
+    int fd;
+    void *addr;
+    
+    /* check the args */
+    if (shm == NULL)
+    {
+        return 2;
+    }
+    if ((a_isd17xx_shm_name(name) != 0) || (device_num == 0) || (device_num > ISD17XX_SHM_MAX_DEVICE))
+    {
+        return 4;
+    }
+    
+    /* a fresh object, readers of the old one keep their mapping */
+    (void)shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        perror("isd17xx: shm open failed.\n");
+        
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(isd17xx_shm_page_t)) != 0)
+    {
+        perror("isd17xx: shm truncate failed.\n");
+        (void)close(fd);
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(isd17xx_shm_page_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        perror("isd17xx: shm map failed.\n");
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    
+    /* fill the header, the magic goes last so readers never see a half page */
+    memset(shm, 0, sizeof(isd17xx_shm_t));
+    shm->page = (isd17xx_shm_page_t *)addr;
+    strcpy(shm->name, name);
+    shm->owner = 1;
+    shm->page->version = ISD17XX_SHM_VERSION;
+    shm->page->device_num = device_num;
+    shm->page->pid = (uint32_t)getpid();
+    for (i = 0; i < device_num; i++)
+    {
+        shm->page->device[i].last_command = ISD17XX_SHM_NO_COMMAND;
+    }
+    __atomic_store_n(&shm->page->magic, ISD17XX_SHM_MAGIC, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     unmap and remove the page
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_shm_destroy(isd17xx_shm_t *shm)
+{
+    /* check the handle */
+    if (shm == NULL)
+    {
+        return 2;
+    }
+    
+    /* unmap and unlink */
+    if (shm->page != NULL)
+    {
+        (void)munmap(shm->page, sizeof(isd17xx_shm_page_t));
+        shm->page = NULL;
+    }
+    if (shm->owner != 0)
+    {
+        (void)shm_unlink(shm->name);
+        shm->owner = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     publish a device snapshot
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] id device id
+ * @param[in] *snapshot pointer to a snapshot structure
+ * @param[in] command finished command, ISD17XX_SHM_NO_COMMAND for a plain status update
+ * @param[in] res status code of the command
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      no syscall, readers never block the publisher
+ */
+uint8_t isd17xx_shm_publish(isd17xx_shm_t *shm, uint16_t id, const isd17xx_snapshot_t *snapshot,
+                            uint8_t command, uint8_t res)
+{
+    uint32_t sequence;
+    uint64_t now;
+    isd17xx_shm_device_t *device;
+    
+    /* check the args */
+    if ((shm == NULL) || (shm->page == NULL) || (snapshot == NULL))
+    {
+        return 2;
+    }
+    if (id >= shm->page->device_num)
+    {
+        return 4;
+    }
+    device = &shm->page->device[id];
+    now = isd17xx_interface_get_time_us();
+    
+    /* odd sequence while writing */
+    sequence = __atomic_load_n(&device->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&device->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    
+    /* write the fields */
+    device->valid = 1;
+    device->status1 = snapshot->status1;
+    device->status2 = snapshot->status2;
+    device->play_point = snapshot->play_point;
+    device->record_point = snapshot->record_point;
+    device->update_count++;
+    device->update_us = now;
+    if (command != ISD17XX_SHM_NO_COMMAND)
+    {
+        device->last_command = command;
+        device->last_res = res;
+        device->command_count++;
+        if (res != 0)
+        {
+            device->error_count++;
+        }
+        device->command_us = now;
+    }
+    
+    /* even sequence again */
+    __atomic_store_n(&device->sequence, sequence + 2, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      map the page as a reader
+ * @param[in]  *name pointer to a shm object name
+ * @param[out] *shm pointer to a shm handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 handle is NULL
+ *             - 4 page is invalid
+ * @note       none
+ */
+uint8_t isd17xx_shm_open(const char *name, isd17xx_shm_t *shm)
+{
+    int fd;
+    void *addr;
+    
+    /* check the args */
+    if (shm == NULL)
+    {
+        return 2;
+    }
+    if (a_isd17xx_shm_name(name) != 0)
+    {
+        return 4;
+    }
+    
+    /* map read only */
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        perror("isd17xx: shm open failed.\n");
+        
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(isd17xx_shm_page_t), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        perror("isd17xx: shm map failed.\n");
+        
+        return 1;
+    }
+    memset(shm, 0, sizeof(isd17xx_shm_t));
+    shm->page = (isd17xx_shm_page_t *)addr;
+    strcpy(shm->name, name);
+    
+    /* check the layout */
+    if ((__atomic_load_n(&shm->page->magic, __ATOMIC_ACQUIRE) != ISD17XX_SHM_MAGIC) ||
+        (shm->page->version != ISD17XX_SHM_VERSION) || (shm->page->device_num > ISD17XX_SHM_MAX_DEVICE))
+    {
+        isd17xx_interface_debug_print("isd17xx: shm page is invalid.\n");
+        (void)munmap(addr, sizeof(isd17xx_shm_page_t));
+        shm->page = NULL;
+        
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     unmap the page
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_shm_close(isd17xx_shm_t *shm)
+{
+    /* check the handle */
+    if (shm == NULL)
+    {
+        return 2;
+    }
+    
+    /* unmap */
+    if (shm->page != NULL)
+    {
+        (void)munmap(shm->page, sizeof(isd17xx_shm_page_t));
+        shm->page = NULL;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      read a consistent device snapshot
+ * @param[in]  *shm pointer to a shm handle structure
+ * @param[in]  id device id
+ * @param[out] *device pointer to a device structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 id is invalid
+ *             - 5 nothing is published yet
+ *             - 6 page is busy
+ * @note       no syscall and no spi traffic, retries while the publisher writes,
+ *             gives up after ISD17XX_SHM_MAX_RETRY tries so a publisher that died
+ *             mid write can not hang the reader
+ */
+uint8_t isd17xx_shm_read(isd17xx_shm_t *shm, uint16_t id, isd17xx_shm_device_t *device)
+{
+    uint32_t retry;
+    uint32_t begin;
+    uint32_t end;
+    const isd17xx_shm_device_t *src;
+    
+    /* check the args */
+    if ((shm == NULL) || (shm->page == NULL) || (device == NULL))
+    {
+        return 2;
+    }
+    if (id >= shm->page->device_num)
+    {
+        return 4;
+    }
+    src = &shm->page->device[id];
+    
+    /* copy until the sequence is even and unchanged */
+    for (retry = 0; retry < ISD17XX_SHM_MAX_RETRY; retry++)
+    {
+        begin = __atomic_load_n(&src->sequence, __ATOMIC_ACQUIRE);
+        if ((begin & 1) != 0)
+        {
+            continue;
+        }
+        memcpy(device, src, sizeof(isd17xx_shm_device_t));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&src->sequence, __ATOMIC_RELAXED);
+        if (begin == end)
+        {
+            break;
+        }
+    }
+    if (retry == ISD17XX_SHM_MAX_RETRY)
+    {
+        return 6;
+    }
+    device->sequence = begin;
+    
+    return (device->valid != 0) ? 0 : 5;
+}
@@ -65,6 +65,21 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 } spi_mode_type_t;
 
+/**
+ * @brief spi max segment definition
+ */
+#define SPI_MAX_SEGMENT        8        /**< max segments in one message */
+
+/**
+ * @brief spi segment structure definition
+ */
+typedef struct spi_segment_s
+{
+    uint8_t *tx;         /**< tx buffer */
+    uint8_t *rx;         /**< rx buffer */
+    uint16_t len;        /**< length of both buffers */
+} spi_segment_t;
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -191,6 +206,19 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
  */
 uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len);
 
+/**
+ * @brief         spi transmit vector
+ * @param[in]     fd spi handle
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          all segments go in one ioctl and the chip select toggles between them,
+ *                num is 1 to SPI_MAX_SEGMENT
+ */
+uint8_t spi_transmit_vector(int fd, spi_segment_t *seg, uint8_t num);
+
 /**
  * @}
  */
@@ -207,36 +207,31 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
-    uint8_t recv[len + 1];
+    struct spi_ioc_transfer k[2];
     int l;
     
-    /* set the command */
-    command[0] = reg;
-    memset(&command[1], 0x00, len);
-    
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 1;
-    k.cs_change = 0;
+    /* set the command, the chip select stays low into the payload */
+    k[0].tx_buf = (unsigned long)&reg;
+    k[0].len = 1;
+    k[0].cs_change = 0;
+    
+    /* receive straight into the caller buffer, a null tx clocks out zeros */
+    k[1].rx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 1, len);
-    
     return 0;
 }
 
@@ -253,37 +248,36 @@ uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_read_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
-    uint8_t recv[len + 2];
+    struct spi_ioc_transfer k[2];
+    uint8_t command[2];
     int l;
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memset(&command[2], 0x00, len);
     
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.rx_buf = (unsigned long)recv;
-    k.len = len + 2;
-    k.cs_change = 0;
+    /* set the command, the chip select stays low into the payload */
+    k[0].tx_buf = (unsigned long)command;
+    k[0].len = 2;
+    k[0].cs_change = 0;
+    
+    /* receive straight into the caller buffer, a null tx clocks out zeros */
+    k[1].rx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
         return 1;
     }
     
-    /* copy the data */
-    memcpy(buf, recv + 2, len);
-    
     return 0;
 }
 
@@ -335,25 +329,25 @@ uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 1];
+    struct spi_ioc_transfer k[2];
     int l;
     
-    /* set the command */
-    command[0] = reg;
-    memcpy(&command[1], buf, len);
-    
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 1;
-    k.cs_change = 0;
+    /* set the command, the chip select stays low into the payload */
+    k[0].tx_buf = (unsigned long)&reg;
+    k[0].len = 1;
+    k[0].cs_change = 0;
+    
+    /* send straight from the caller buffer */
+    k[1].tx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
@@ -376,26 +370,30 @@ uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    struct spi_ioc_transfer k;
-    uint8_t command[len + 2];
+    struct spi_ioc_transfer k[2];
+    uint8_t command[2];
     int l;
     
     /* set the command */
     command[0] = (reg >> 8) & 0xFF;
     command[1] = reg & 0xFF;
-    memcpy(&command[2], buf, len);
     
     /* clear ioc transfer */
-    memset(&k, 0, sizeof(struct spi_ioc_transfer));
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * 2);
     
-    /* set the param */
-    k.tx_buf = (unsigned long)command;
-    k.len = len + 2;
-    k.cs_change = 0;
+    /* set the command, the chip select stays low into the payload */
+    k[0].tx_buf = (unsigned long)command;
+    k[0].len = 2;
+    k[0].cs_change = 0;
+    
+    /* send straight from the caller buffer */
+    k[1].tx_buf = (unsigned long)buf;
+    k[1].len = len;
+    k[1].cs_change = 0;
     
     /* transmit */
-    l = ioctl(fd, SPI_IOC_MESSAGE(1), &k);
-    if (l != k.len)
+    l = ioctl(fd, SPI_IOC_MESSAGE(2), k);
+    if (l != (int)(k[0].len + k[1].len))
     {
         perror("spi: length check error.\n");
         
@@ -512,3 +510,53 @@ uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len)
     
     return 0;
 }
+
+/**
+ * @brief         spi transmit vector
+ * @param[in]     fd spi handle
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          all segments go in one ioctl and the chip select toggles between them,
+ *                num is 1 to SPI_MAX_SEGMENT
+ */
+uint8_t spi_transmit_vector(int fd, spi_segment_t *seg, uint8_t num)
+{
+    struct spi_ioc_transfer k[SPI_MAX_SEGMENT];
+    uint32_t total;
+    uint8_t i;
+    int l;
+    
+    /* check the number */
+    if ((num == 0) || (num > SPI_MAX_SEGMENT))
+    {
+        return 1;
+    }
+    
+    /* clear ioc transfer */
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * num);
+    
+    /* set the param */
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        k[i].tx_buf = (unsigned long)seg[i].tx;
+        k[i].rx_buf = (unsigned long)seg[i].rx;
+        k[i].len = seg[i].len;
+        k[i].cs_change = (i != (num - 1)) ? 1 : 0;
+        total += seg[i].len;
+    }
+    
+    /* transmit */
+    l = ioctl(fd, SPI_IOC_MESSAGE(num), k);
+    if (l != (int)total)
+    {
+        perror("spi: length check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
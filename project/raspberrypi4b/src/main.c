@@ -37,11 +37,81 @@
 #include "driver_isd17xx_register_test.h"
 #include "driver_isd17xx_play_record_test.h"
 #include "driver_isd17xx_basic.h"
+#include "raspberrypi4b_driver_isd17xx_daemon.h"
+#include "raspberrypi4b_driver_isd17xx_shm.h"
+#include "raspberrypi4b_driver_isd17xx_script.h"
+#include "raspberrypi4b_driver_isd17xx_monitor.h"
 #include <getopt.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief      send one request to the daemon
+ * @param[in]  *path pointer to a socket path
+ * @param[in]  command daemon command
+ * @param[in]  flags request flags
+ * @param[in]  start_addr start address
+ * @param[in]  end_addr end address
+ * @param[out] *response pointer to a response structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_client_request(const char *path, isd17xx_daemon_command_t command, uint8_t flags,
+                                        uint16_t start_addr, uint16_t end_addr, isd17xx_daemon_response_t *response)
+{
+    uint64_t t;
+    isd17xx_daemon_request_t request;
+    
+    /* fill the request */
+    memset(&request, 0, sizeof(request));
+    request.command = (uint8_t)command;
+    request.flags = flags;
+    request.start_addr = start_addr;
+    request.end_addr = end_addr;
+    
+    /* send it */
+    t = isd17xx_interface_get_time_us();
+    if (isd17xx_daemon_request(path, &request, response) != 0)
+    {
+        return 1;
+    }
+    t = isd17xx_interface_get_time_us() - t;
+    
+    /* check the result */
+    if (response->res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: daemon command failed with %d.\n", response->res);
+        
+        return 1;
+    }
+    if ((flags & ISD17XX_DAEMON_FLAG_WAIT) == 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: request took %llu us.\n", (unsigned long long)t);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     print a status page entry
+ * @param[in] *device pointer to a device structure
+ * @note      none
+ */
+static void a_isd17xx_view_print(const isd17xx_shm_device_t *device)
+{
+    isd17xx_interface_debug_print("isd17xx: update %u at %llu us, status1 0x%04X, status2 0x%02X, play point 0x%04X, record point 0x%04X.\n",
+                                  device->update_count, (unsigned long long)device->update_us, device->status1,
+                                  device->status2, device->play_point, device->record_point);
+    if (device->last_command != ISD17XX_SHM_NO_COMMAND)
+    {
+        isd17xx_interface_debug_print("isd17xx: last command %d returned %d, %u commands, %u errors.\n",
+                                      device->last_command, device->last_res, device->command_count, device->error_count);
+    }
+}
+
 /**
  * @brief     isd17xx full function
  * @param[in] argc arg numbers
@@ -56,7 +126,7 @@ uint8_t isd17xx(uint8_t argc, char **argv)
 {
     int c;
     int longindex = 0;
-    char short_options[] = "hipe:t:";
+    char short_options[] = "hipe:t:c:dvs:m";
     struct option long_options[] =
     {
         {"help", no_argument, NULL, 'h'},
@@ -64,15 +134,33 @@ uint8_t isd17xx(uint8_t argc, char **argv)
         {"port", no_argument, NULL, 'p'},
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
+        {"client", required_argument, NULL, 'c'},
+        {"daemon", no_argument, NULL, 'd'},
+        {"view", no_argument, NULL, 'v'},
+        {"script", required_argument, NULL, 's'},
+        {"monitor", no_argument, NULL, 'm'},
         {"end", required_argument, NULL, 1},
         {"start", required_argument, NULL, 2},
         {"type", required_argument, NULL, 3},
+        {"socket", required_argument, NULL, 4},
+        {"shm", required_argument, NULL, 5},
+        {"follow", no_argument, NULL, 6},
+        {"rate", required_argument, NULL, 7},
+        {"duration", required_argument, NULL, 8},
+        {"format", required_argument, NULL, 9},
+        {"output", required_argument, NULL, 10},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint16_t start = 0x0000;
     uint16_t end =0x00FF;
     isd17xx_type_t chip_type = ISD1760;
+    char socket_path[108] = ISD17XX_DAEMON_DEFAULT_SOCKET;
+    char shm_name[32] = ISD17XX_SHM_DEFAULT_NAME;
+    uint8_t follow = 0;
+    char script_path[256] = {0};
+    char output_path[256] = {0};
+    isd17xx_monitor_config_t monitor_config = {ISD17XX_MONITOR_DEFAULT_RATE, 0, ISD17XX_MONITOR_FORMAT_CSV, NULL};
     
     /* if no params */
     if (argc == 1)
@@ -143,6 +231,64 @@ uint8_t isd17xx(uint8_t argc, char **argv)
                 break;
             }
 
+            /* client */
+            case 'c' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "c_%s", optarg);
+
+                break;
+            }
+
+            /* daemon */
+            case 'd' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "d");
+
+                break;
+            }
+
+            /* view */
+            case 'v' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "v");
+
+                break;
+            }
+
+            /* script */
+            case 's' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "s");
+                
+                /* set the path */
+                if (strlen(optarg) >= sizeof(script_path))
+                {
+                    return 5;
+                }
+                memset(script_path, 0, sizeof(script_path));
+                strncpy(script_path, optarg, sizeof(script_path) - 1);
+
+                break;
+            }
+
+            /* monitor */
+            case 'm' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "m");
+
+                break;
+            }
+
             /* end */
             case 1 :
             {
@@ -319,6 +465,110 @@ uint8_t isd17xx(uint8_t argc, char **argv)
                 {
                     return 5;
                 }
+                
+                break;
+            }
+            
+            /* socket path */
+            case 4 :
+            {
+                /* set the path */
+                if (strlen(optarg) >= sizeof(socket_path))
+                {
+                    return 5;
+                }
+                memset(socket_path, 0, sizeof(socket_path));
+                strncpy(socket_path, optarg, sizeof(socket_path) - 1);
+                
+                break;
+            }
+            
+            /* shm */
+            case 5 :
+            {
+                /* set the name */
+                if (strlen(optarg) >= sizeof(shm_name))
+                {
+                    return 5;
+                }
+                memset(shm_name, 0, sizeof(shm_name));
+                strncpy(shm_name, optarg, sizeof(shm_name) - 1);
+                
+                break;
+            }
+            
+            /* follow */
+            case 6 :
+            {
+                /* keep printing */
+                follow = 1;
+                
+                break;
+            }
+            
+            /* rate */
+            case 7 :
+            {
+                char *p;
+                
+                /* set the rate, 0 is as fast as possible */
+                monitor_config.rate_hz = (uint32_t)strtoul(optarg, &p, 10);
+                if ((p == optarg) || (*p != '\0') || (monitor_config.rate_hz > 1000000))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* duration */
+            case 8 :
+            {
+                char *p;
+                
+                /* set the duration in ms */
+                monitor_config.duration_ms = (uint32_t)strtoul(optarg, &p, 10);
+                if ((p == optarg) || (*p != '\0'))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* format */
+            case 9 :
+            {
+                /* set the format */
+                if (strcmp("csv", optarg) == 0)
+                {
+                    monitor_config.format = ISD17XX_MONITOR_FORMAT_CSV;
+                }
+                else if (strcmp("bin", optarg) == 0)
+                {
+                    monitor_config.format = ISD17XX_MONITOR_FORMAT_BINARY;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* output */
+            case 10 :
+            {
+                /* set the path */
+                if (strlen(optarg) >= sizeof(output_path))
+                {
+                    return 5;
+                }
+                memset(output_path, 0, sizeof(output_path));
+                strncpy(output_path, optarg, sizeof(output_path) - 1);
+                monitor_config.path = output_path;
+                
+                break;
             }
             
             /* the end */
@@ -508,6 +758,216 @@ uint8_t isd17xx(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("d", type) == 0)
+    {
+        /* serve until stopped */
+        if (isd17xx_daemon_run(chip_type, socket_path, shm_name) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("c_play", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: playing...\n");
+        
+        /* play and wait */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_PLAY, ISD17XX_DAEMON_FLAG_WAIT,
+                                     start, end, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: finish.\n");
+        
+        return 0;
+    }
+    else if (strcmp("c_record", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* erase and wait */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_ERASE, ISD17XX_DAEMON_FLAG_WAIT,
+                                     start, end, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: recording...\n");
+        
+        /* record and wait */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_RECORD, ISD17XX_DAEMON_FLAG_WAIT,
+                                     start, end, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: finish.\n");
+        
+        return 0;
+    }
+    else if (strcmp("c_erase", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* erase and wait */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_ERASE, ISD17XX_DAEMON_FLAG_WAIT,
+                                     start, end, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: finish.\n");
+        
+        return 0;
+    }
+    else if (strcmp("c_global-erase", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: global erase.\n");
+        
+        /* global erase and wait */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_GLOBAL_ERASE, ISD17XX_DAEMON_FLAG_WAIT,
+                                     0, 0, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: finish.\n");
+        
+        return 0;
+    }
+    else if (strcmp("c_stop", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* stop */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_STOP, 0, 0, 0, &response) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("c_status", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* read the status */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_STATUS, 0, 0, 0, &response) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_interface_debug_print("isd17xx: status1 is 0x%04X.\n", response.status1);
+        isd17xx_interface_debug_print("isd17xx: status2 is 0x%02X.\n", response.status2);
+        isd17xx_interface_debug_print("isd17xx: play point is 0x%04X.\n", response.play_point);
+        isd17xx_interface_debug_print("isd17xx: record point is 0x%04X.\n", response.record_point);
+        
+        return 0;
+    }
+    else if (strcmp("c_shutdown", type) == 0)
+    {
+        isd17xx_daemon_response_t response;
+        
+        /* stop the daemon */
+        if (a_isd17xx_client_request(socket_path, ISD17XX_DAEMON_COMMAND_SHUTDOWN, 0, 0, 0, &response) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("s", type) == 0)
+    {
+        isd17xx_script_t script;
+        
+        /* check the whole script first */
+        if (isd17xx_script_load(script_path, &script) != 0)
+        {
+            return 1;
+        }
+        
+        /* run it in one session */
+        if (isd17xx_script_run(chip_type, &script) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("m", type) == 0)
+    {
+        isd17xx_monitor_report_t report;
+        
+        /* sample until the duration ends or SIGINT */
+        if (isd17xx_monitor_run(chip_type, &monitor_config, &report) != 0)
+        {
+            return 1;
+        }
+        
+        /* output */
+        isd17xx_monitor_print_report(&report);
+        
+        return 0;
+    }
+    else if (strcmp("v", type) == 0)
+    {
+        uint8_t res;
+        uint32_t last;
+        isd17xx_shm_t shm;
+        isd17xx_shm_device_t device;
+        
+        /* map the status page of the daemon */
+        if (isd17xx_shm_open(shm_name, &shm) != 0)
+        {
+            return 1;
+        }
+        
+        /* print once or on every update, reading the page needs no syscall */
+        last = 0;
+        while (1)
+        {
+            res = isd17xx_shm_read(&shm, 0, &device);
+            if (res == 0)
+            {
+                if ((follow == 0) || (device.update_count != last))
+                {
+                    a_isd17xx_view_print(&device);
+                    last = device.update_count;
+                }
+            }
+            else if (follow == 0)
+            {
+                isd17xx_interface_debug_print((res == 6) ? "isd17xx: status page is busy.\n" :
+                                              "isd17xx: nothing is published.\n");
+            }
+            else
+            {
+                /* wait for the first update or a quiet page */
+            }
+            if (follow == 0)
+            {
+                break;
+            }
+            isd17xx_interface_delay_ms(10);
+        }
+        (void)isd17xx_shm_close(&shm);
+        
+        return (res == 0) ? 0 : 1;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -523,19 +983,46 @@ uint8_t isd17xx(uint8_t argc, char **argv)
         isd17xx_interface_debug_print("          [--type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>]\n");
         isd17xx_interface_debug_print("  isd17xx (-e global-erase | --example=global-erase)\n");
         isd17xx_interface_debug_print("          [--type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-d | --daemon) [--socket=<path>] [--shm=<name>]\n");
+        isd17xx_interface_debug_print("          [--type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-c play | --client=play) [--start=<hex>] [--end=<hex>] [--socket=<path>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-c record | --client=record) [--start=<hex>] [--end=<hex>] [--socket=<path>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-c erase | --client=erase) [--start=<hex>] [--end=<hex>] [--socket=<path>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-c <global-erase | stop | status | shutdown> | --client=<global-erase | stop | status | shutdown>) [--socket=<path>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-s <file> | --script=<file>)\n");
+        isd17xx_interface_debug_print("          [--type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-m | --monitor) [--rate=<hz>] [--duration=<ms>] [--format=<csv | bin>] [--output=<file>]\n");
+        isd17xx_interface_debug_print("          [--type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>]\n");
+        isd17xx_interface_debug_print("  isd17xx (-v | --view) [--follow] [--shm=<name>]\n");
         isd17xx_interface_debug_print("\n");
         isd17xx_interface_debug_print("Options:\n");
+        isd17xx_interface_debug_print("  -c <play | record | erase | global-erase | stop | status | shutdown>, --client=<play | record | erase | global-erase | stop | status | shutdown>\n");
+        isd17xx_interface_debug_print("                       Send the command to the running daemon.\n");
+        isd17xx_interface_debug_print("  -d, --daemon         Keep the chip initialized and serve client commands.\n");
         isd17xx_interface_debug_print("  -e <record | play | global-erase>, --example=<record | play | global-erase>\n");
         isd17xx_interface_debug_print("                       Run the driver example.\n");
+        isd17xx_interface_debug_print("      --duration=<ms>  Set the monitor run time, 0 runs until SIGINT.([default: 0])\n");
         isd17xx_interface_debug_print("      --end=<hex>      Set the end address and it is hexadecimal.([default: 0xFF])\n");
+        isd17xx_interface_debug_print("      --follow         Keep printing the status page on every update.\n");
+        isd17xx_interface_debug_print("      --format=<csv | bin>\n");
+        isd17xx_interface_debug_print("                       Set the monitor output format.([default: csv])\n");
         isd17xx_interface_debug_print("  -h, --help           Show the help.\n");
         isd17xx_interface_debug_print("  -i, --information    Show the chip information.\n");
+        isd17xx_interface_debug_print("  -m, --monitor        Sample the status and points with timestamps, the chip is reset first\n");
+        isd17xx_interface_debug_print("                       and powered down at the end, so a running play or record is not seen.\n");
+        isd17xx_interface_debug_print("      --output=<file>  Set the monitor output file.([default: stdout])\n");
         isd17xx_interface_debug_print("  -p, --port           Display the pin connections of the current board.\n");
+        isd17xx_interface_debug_print("      --rate=<hz>      Set the monitor sample rate, 0 samples as fast as the spi allows.([default: %d])\n", ISD17XX_MONITOR_DEFAULT_RATE);
+        isd17xx_interface_debug_print("  -s <file>, --script=<file>\n");
+        isd17xx_interface_debug_print("                       Run the erase, record, play, global-erase, stop, wait, delay and set lines of the file in one session.\n");
+        isd17xx_interface_debug_print("      --shm=<name>     Set the daemon status page name.([default: %s])\n", ISD17XX_SHM_DEFAULT_NAME);
+        isd17xx_interface_debug_print("      --socket=<path>  Set the daemon socket path.([default: %s])\n", ISD17XX_DAEMON_DEFAULT_SOCKET);
         isd17xx_interface_debug_print("      --start=<hex>    Set the start address and it is hexadecimal.([default: 0x00])\n");
         isd17xx_interface_debug_print("  -t <reg | audio>, --test=<reg | audio>\n");
         isd17xx_interface_debug_print("                       Run the driver test.\n");
         isd17xx_interface_debug_print("      --type=<ISD1730 | ISD1740 | ISD1750 | ISD1760 | ISD1790 | ISD17120 | ISD17150 | ISD17180 | ISD17210 | ISD17240>\n");
         isd17xx_interface_debug_print("                       Set the chip type.([default: ISD1760])\n");
+        isd17xx_interface_debug_print("  -v, --view           Show the daemon status page without a request.\n");
 
         return 0;
     }
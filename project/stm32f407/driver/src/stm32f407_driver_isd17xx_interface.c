@@ -110,6 +110,31 @@ uint8_t isd17xx_interface_spi_transmit(uint8_t *tx, uint8_t *rx, uint16_t len)
     return spi_transmit(tx, rx, len);
 }
 
+/**
+ * @brief         interface spi bus transmit vector
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ * @note          every segment is a separate chip select cycle
+ */
+uint8_t isd17xx_interface_spi_transmit_vector(isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    uint8_t i;
+    
+    /* the hal has no queued transfer, so send the segments back to back */
+    for (i = 0; i < num; i++)
+    {
+        if (spi_transmit(seg[i].tx, seg[i].rx, seg[i].len) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  interface gpio reset init
  * @return status code
@@ -157,6 +182,38 @@ void isd17xx_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      optional, the driver only uses it together with get_time_us
+ */
+void isd17xx_interface_delay_us(uint32_t us)
+{
+    delay_us(us);
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t isd17xx_interface_get_time_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    uint32_t load;
+    
+    /* read the tick again if it changed while sampling the counter */
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    load = SysTick->LOAD;
+    
+    return (uint64_t)ms * 1000 + (uint64_t)(load - val) * 1000 / (load + 1);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
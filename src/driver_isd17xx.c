@@ -36,6 +36,27 @@
 
 #include "driver_isd17xx.h"
 
+/**
+ * @brief transport binding definition
+ * @note  define ISD17XX_STATIC_TRANSPORT as a header name to bind the transport at compile time,
+ *        the header provides isd17xx_static_spi_read, isd17xx_static_spi_write,
+ *        isd17xx_static_spi_transmit and isd17xx_static_delay_ms as static inline functions,
+ *        only a header holding the bus access itself lets the compiler inline the transport without lto,
+ *        the handle links are still required by init and by the other modules
+ */
+#ifdef ISD17XX_STATIC_TRANSPORT
+    #include ISD17XX_STATIC_TRANSPORT
+    #define ISD17XX_BIND_SPI_READ(HANDLE, REG, BUF, LEN)       isd17xx_static_spi_read(REG, BUF, LEN)
+    #define ISD17XX_BIND_SPI_WRITE(HANDLE, REG, BUF, LEN)      isd17xx_static_spi_write(REG, BUF, LEN)
+    #define ISD17XX_BIND_SPI_TRANSMIT(HANDLE, TX, RX, LEN)     isd17xx_static_spi_transmit(TX, RX, LEN)
+    #define ISD17XX_BIND_DELAY_MS(HANDLE, MS)                  isd17xx_static_delay_ms(MS)
+#else
+    #define ISD17XX_BIND_SPI_READ(HANDLE, REG, BUF, LEN)       (HANDLE)->spi_read(REG, BUF, LEN)
+    #define ISD17XX_BIND_SPI_WRITE(HANDLE, REG, BUF, LEN)      (HANDLE)->spi_write(REG, BUF, LEN)
+    #define ISD17XX_BIND_SPI_TRANSMIT(HANDLE, TX, RX, LEN)     (HANDLE)->spi_transmit(TX, RX, LEN)
+    #define ISD17XX_BIND_DELAY_MS(HANDLE, MS)                  (HANDLE)->delay_ms(MS)
+#endif
+
 /**
  * @brief chip information definition
  */
@@ -49,32 +70,15 @@
 #define DRIVER_VERSION            1000                     /**< driver version */
 
 /**
- * @brief chip command definition
- */
-#define ISD17XX_COMMAND_PU              0x01        /**< power up command */
-#define ISD17XX_COMMAND_STOP            0x02        /**< stop command */
-#define ISD17XX_COMMAND_RESET           0x03        /**< reset command */
-#define ISD17XX_COMMAND_CLR_INT         0x04        /**< clear interrupt command */
-#define ISD17XX_COMMAND_RD_STATUS       0x05        /**< read status command */
-#define ISD17XX_COMMAND_RD_PLAY_PTR     0x06        /**< read play point command */
-#define ISD17XX_COMMAND_PD              0x07        /**< power down command */
-#define ISD17XX_COMMAND_RD_REC_PTR      0x08        /**< read record point command */
-#define ISD17XX_COMMAND_DEVID           0x09        /**< device id command */
-#define ISD17XX_COMMAND_PLAY            0x40        /**< play command */
-#define ISD17XX_COMMAND_REC             0x41        /**< record command */
-#define ISD17XX_COMMAND_ERASE           0x42        /**< erase command */
-#define ISD17XX_COMMAND_G_ERASE         0x43        /**< erase all command */
-#define ISD17XX_COMMAND_RD_APC          0x44        /**< read apc command */
-#define ISD17XX_COMMAND_WR_APC1         0x45        /**< write apc1 command */
-#define ISD17XX_COMMAND_WR_APC2         0x65        /**< write apc2 command */
-#define ISD17XX_COMMAND_WR_NVCFG        0x46        /**< write nvcfg command */
-#define ISD17XX_COMMAND_LD_NVCFG        0x47        /**< load nvcfg command */
-#define ISD17XX_COMMAND_FWD             0x48        /**< forward command */
-#define ISD17XX_COMMAND_CHK_MEM         0x49        /**< check memory command */
-#define ISD17XX_COMMAND_EXTCLK          0x4A        /**< extern clock command */
-#define ISD17XX_COMMAND_SET_PLAY        0x80        /**< set play command */
-#define ISD17XX_COMMAND_SET_REC         0x81        /**< set record command */
-#define ISD17XX_COMMAND_SET_ERASE       0x82        /**< set erase command */
+ * @brief chip default command delay definition
+ */
+#define ISD17XX_DEFAULT_COMMAND_DELAY   500         /**< 500ms */
+
+/**
+ * @brief chip memory definition
+ */
+#define ISD17XX_MESSAGE_START_ADDRESS   0x010       /**< first message row, 0x000 - 0x00F are sound effects */
+#define ISD17XX_READY_TIMEOUT           1000        /**< ready timeout in ms */
 
 /**
  * @brief     high low shift
@@ -108,22 +112,98 @@ static uint8_t a_isd17xx_spi_transmit(isd17xx_handle_t *handle, uint8_t *tx, uin
 {
     uint16_t i;
     
-    for (i = 0; i < len; i++)                         /* loop all */
+    for (i = 0; i < len; i++)                                       /* loop all */
+    {
+        tx[i] = a_high_low_shift(tx[i]);                            /* msb to lsb */
+    }
+    
+    handle->frame_count++;                                          /* count the frame */
+    if (ISD17XX_BIND_SPI_TRANSMIT(handle, tx, rx, len) != 0)        /* spi transmit */
+    {
+        return 1;                                                   /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                                       /* loop all */
+    {
+        rx[i] = a_high_low_shift(rx[i]);                            /* msb to lsb */
+    }
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief         send several encoded frames
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 spi transmit vector failed
+ * @note          falls back to one spi_transmit per segment when spi_transmit_vector is not linked
+ */
+static uint8_t a_isd17xx_frame_transmit(isd17xx_handle_t *handle, isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    uint8_t i;
+    
+    handle->frame_count += num;                                                                  /* count the frames */
+    if (handle->spi_transmit_vector != NULL)                                                     /* check spi_transmit_vector */
+    {
+        if (handle->spi_transmit_vector(seg, num) != 0)                                          /* spi transmit vector */
+        {
+            return 1;                                                                            /* return error */
+        }
+    }
+    else
+    {
+        for (i = 0; i < num; i++)                                                                /* loop all segments */
+        {
+            if (ISD17XX_BIND_SPI_TRANSMIT(handle, seg[i].tx, seg[i].rx, seg[i].len) != 0)        /* spi transmit */
+            {
+                return 1;                                                                        /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief         write and read several frames
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 spi transmit vector failed
+ * @note          falls back to one spi_transmit per segment when spi_transmit_vector is not linked
+ */
+static uint8_t a_isd17xx_spi_transmit_vector(isd17xx_handle_t *handle, isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    uint8_t i;
+    uint16_t j;
+    
+    for (i = 0; i < num; i++)                                                                    /* loop all segments */
     {
-        tx[i] = a_high_low_shift(tx[i]);              /* msb to lsb */
+        for (j = 0; j < seg[i].len; j++)                                                         /* loop all */
+        {
+            seg[i].tx[j] = a_high_low_shift(seg[i].tx[j]);                                       /* msb to lsb */
+        }
     }
     
-    if (handle->spi_transmit(tx, rx, len) != 0)       /* spi transmit */
+    if (a_isd17xx_frame_transmit(handle, seg, num) != 0)                                         /* send the frames */
     {
-        return 1;                                     /* return error */
+        return 1;                                                                                /* return error */
     }
     
-    for (i = 0; i < len; i++)                         /* loop all */
+    for (i = 0; i < num; i++)                                                                    /* loop all segments */
     {
-        rx[i] = a_high_low_shift(rx[i]);              /* msb to lsb */
+        for (j = 0; j < seg[i].len; j++)                                                         /* loop all */
+        {
+            seg[i].rx[j] = a_high_low_shift(seg[i].rx[j]);                                       /* msb to lsb */
+        }
     }
     
-    return 0;                                         /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
@@ -141,17 +221,18 @@ static uint8_t a_isd17xx_spi_read(isd17xx_handle_t *handle, uint8_t reg, uint8_t
 {
     uint16_t i;
     
-    if (handle->spi_read(a_high_low_shift(reg), buf, len) != 0)        /* spi read */
+    handle->frame_count++;                                                          /* count the frame */
+    if (ISD17XX_BIND_SPI_READ(handle, a_high_low_shift(reg), buf, len) != 0)        /* spi read */
     {
-        return 1;                                                      /* return error */
+        return 1;                                                                   /* return error */
     }
     
-    for (i = 0; i < len; i++)                                          /* loop all */
+    for (i = 0; i < len; i++)                                                       /* loop all */
     {
-        buf[i] = a_high_low_shift(buf[i]);                             /* msb to lsb */
+        buf[i] = a_high_low_shift(buf[i]);                                          /* msb to lsb */
     }
     
-    return 0;                                                          /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
@@ -169,17 +250,178 @@ static uint8_t a_isd17xx_spi_write(isd17xx_handle_t *handle, uint8_t reg, uint8_
 {
     uint16_t i;
     
-    for (i = 0; i < len; i++)                                           /* loop all */
+    for (i = 0; i < len; i++)                                                        /* loop all */
     {
-        buf[i] = a_high_low_shift(buf[i]);                              /* msb to lsb */
+        buf[i] = a_high_low_shift(buf[i]);                                           /* msb to lsb */
     }
     
-    if (handle->spi_write(a_high_low_shift(reg), buf, len) != 0)        /* spi write */
+    handle->status_cache_valid = 0;                                                  /* the command may change the status */
+    handle->frame_count++;                                                           /* count the frame */
+    if (ISD17XX_BIND_SPI_WRITE(handle, a_high_low_shift(reg), buf, len) != 0)        /* spi write */
     {
-        return 1;                                                       /* return error */
+        return 1;                                                                    /* return error */
     }
     
-    return 0;                                                           /* success return 0 */
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     store the status in the cache
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] status1 status1
+ * @param[in] status2 status2
+ * @note      none
+ */
+static void a_isd17xx_status_cache_store(isd17xx_handle_t *handle, uint16_t status1, uint8_t status2)
+{
+    if ((handle->status_max_age != 0) && (handle->get_time_us != NULL))        /* check the cache */
+    {
+        handle->status1_cache = status1;                                       /* save the status1 */
+        handle->status2_cache = status2;                                       /* save the status2 */
+        handle->status_cache_time = handle->get_time_us();                     /* save the timestamp */
+        handle->status_cache_valid = 1;                                        /* flag valid */
+    }
+}
+
+/**
+ * @brief     get the driver clock
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    time in us
+ * @note      get_time_us when delay_us and get_time_us are linked, otherwise the delay_ms driven clock
+ */
+static uint64_t a_isd17xx_clock(isd17xx_handle_t *handle)
+{
+    if ((handle->delay_us != NULL) && (handle->get_time_us != NULL))        /* check the timed links */
+    {
+        return handle->get_time_us();                                       /* return the real time */
+    }
+    
+    return handle->clock_us;                                                /* return the delay driven time */
+}
+
+/**
+ * @brief     wait until a deadline
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] deadline_us deadline on the driver clock in us
+ * @note      the delay_us overshoot is recorded, delay_ms waits are rounded up to ms
+ */
+static void a_isd17xx_delay_until(isd17xx_handle_t *handle, uint64_t deadline_us)
+{
+    uint32_t ms;
+    uint64_t us;
+    uint64_t now;
+    
+    now = a_isd17xx_clock(handle);                                                  /* get the time */
+    if (now >= deadline_us)                                                         /* check the deadline */
+    {
+        return;                                                                     /* already passed */
+    }
+    if ((handle->delay_us != NULL) && (handle->get_time_us != NULL))                /* check the timed links */
+    {
+        us = deadline_us - now;                                                     /* get the remaining time */
+        handle->delay_us((us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)us);        /* delay us */
+        now = handle->get_time_us();                                                /* get the wake time */
+        us = (now > deadline_us) ? (now - deadline_us) : 0;                         /* get the overshoot */
+        handle->delay_count++;                                                      /* delay count++ */
+        handle->delay_overshoot_sum += us;                                          /* add the overshoot */
+        if (us > handle->delay_overshoot_max)                                       /* check the max */
+        {
+            handle->delay_overshoot_max = (us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU :
+                                          (uint32_t)us;                             /* set the max */
+        }
+    }
+    else
+    {
+        ms = (uint32_t)((deadline_us - now + 999) / 1000);                          /* round up to ms */
+        ISD17XX_BIND_DELAY_MS(handle, ms);                                          /* delay ms */
+        handle->clock_us += (uint64_t)ms * 1000;                                    /* advance the clock */
+    }
+}
+
+/**
+ * @brief     delay from now
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] ms delay in ms
+ * @note      none
+ */
+static void a_isd17xx_delay_ms(isd17xx_handle_t *handle, uint32_t ms)
+{
+    a_isd17xx_delay_until(handle, a_isd17xx_clock(handle) + (uint64_t)ms * 1000);        /* delay until now + ms */
+}
+
+/**
+ * @brief     wait the command delay
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @note      none
+ */
+static void a_isd17xx_command_delay(isd17xx_handle_t *handle)
+{
+    if (handle->command_delay != 0)                                  /* check the command delay */
+    {
+        a_isd17xx_delay_ms(handle, handle->command_delay);           /* delay ms */
+    }
+}
+
+/**
+ * @brief     wait the ready status
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait ready failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_wait_ready(isd17xx_handle_t *handle, uint32_t timeout_ms)
+{
+    uint16_t status1;
+    uint64_t next;
+    uint64_t end;
+    uint8_t buf[3];
+    uint8_t status_buf[3];
+    
+    next = a_isd17xx_clock(handle);                                                       /* poll from now */
+    end = next + (uint64_t)timeout_ms * 1000;                                             /* set the deadline */
+    while (1)                                                                             /* loop */
+    {
+        buf[0] = ISD17XX_COMMAND_RD_STATUS;                                               /* set read status command */
+        buf[1] = 0x00;                                                                    /* set 0x00 */
+        buf[2] = 0x00;                                                                    /* set 0x00 */
+        if (a_isd17xx_spi_transmit(handle, buf, status_buf, 3) != 0)                      /* read the status */
+        {
+            handle->debug_print("isd17xx: get status failed.\n");                         /* get status failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        status1 = ((uint16_t)status_buf[0]) << 8 | status_buf[1];                         /* set the status1 */
+        if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)                                     /* check the command error */
+        {
+            handle->debug_print("isd17xx: command error.\n");                             /* command error */
+            
+            return 1;                                                                     /* return error */
+        }
+        if ((status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)                 /* check the eom and int */
+        {
+            buf[0] = 0x00;                                                                /* set 0x00 */
+            if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_CLR_INT, buf, 1) != 0)        /* set clear interrupt */
+            {
+                handle->debug_print("isd17xx: set clear interrupt failed.\n");            /* set clear interrupt failed */
+                
+                return 1;                                                                 /* return error */
+            }
+        }
+        if ((status_buf[2] & ISD17XX_STATUS2_RDY) != 0)                                   /* check ready */
+        {
+            return 0;                                                                     /* success return 0 */
+        }
+        if (next >= end)                                                                  /* check the timeout */
+        {
+            handle->debug_print("isd17xx: timeout.\n");                                   /* timeout */
+            
+            return 1;                                                                     /* return error */
+        }
+        next += 1000;                                                                     /* next poll in 1ms */
+        a_isd17xx_delay_until(handle, next);                                              /* delay until the next poll */
+    }
 }
 
 /**
@@ -197,14 +439,13 @@ static uint8_t a_isd17xx_spi_write(isd17xx_handle_t *handle, uint8_t reg, uint8_
 static uint8_t a_isd17xx_check_status(isd17xx_handle_t *handle, uint32_t prev_ms, uint8_t check_status,
                                       uint16_t status, uint32_t timeout_ms)
 {
-    uint8_t flag;
     uint8_t status2;
     uint16_t status1;
-    uint32_t timeout;
+    uint64_t next;
+    uint64_t end;
     uint8_t buf[3];
     uint8_t status_buf[3];
 
-    handle->delay_ms(10);                                                                     /* delay 10ms */
     buf[0] = ISD17XX_COMMAND_RD_STATUS;                                                       /* set read status command */
     buf[1] = 0x00;                                                                            /* set 0x00 */
     buf[2] = 0x00;                                                                            /* set 0x00 */
@@ -228,13 +469,13 @@ static uint8_t a_isd17xx_check_status(isd17xx_handle_t *handle, uint32_t prev_ms
 
     if (prev_ms != 0)                                                                         /* if need prev delay */
     {
-        handle->delay_ms(prev_ms);                                                            /* delay ms */
+        a_isd17xx_delay_ms(handle, prev_ms);                                                  /* delay ms */
     }
     if (check_status != 0)                                                                    /* if check the status */
     {
-        timeout = timeout_ms / 10;                                                            /* set the timeout */
-        flag = 0;                                                                             /* init 0 */
-        while (timeout != 0)                                                                  /* check the timeout */
+        next = a_isd17xx_clock(handle);                                                       /* poll from now */
+        end = next + (uint64_t)timeout_ms * 1000;                                             /* set the deadline */
+        while (1)                                                                             /* loop */
         {
             buf[0] = ISD17XX_COMMAND_RD_STATUS;                                               /* set read status command */
             buf[1] = 0x00;                                                                    /* set 0x00 */
@@ -260,28 +501,19 @@ static uint8_t a_isd17xx_check_status(isd17xx_handle_t *handle, uint32_t prev_ms
 
                     return 1;                                                                 /* return error */
                 }
-                flag = 1;                                                                     /* set flag */
             }
             if ((status2 & status) != 0)                                                      /* check the status */
             {
-                if (flag != 0)
-                {                                                                             /* check the flag */
-                    handle->delay_ms(10);                                                     /* delay 10ms */
-                }
-
                 break;                                                                        /* break */
             }
-            else
+            if (next >= end)                                                                  /* check the timeout */
             {
-                handle->delay_ms(10);                                                         /* delay 10ms */
-                timeout--;                                                                    /* timeout-- */
-                if (timeout == 0)                                                             /* check the timeout */
-                {
-                    handle->debug_print("isd17xx: timeout.\n");                               /* timeout */
+                handle->debug_print("isd17xx: timeout.\n");                                   /* timeout */
 
-                    return 1;                                                                 /* return error */
-                }
+                return 1;                                                                     /* return error */
             }
+            next += 1000;                                                                     /* next poll in 1ms */
+            a_isd17xx_delay_until(handle, next);                                              /* delay until the next poll */
         }
     }
 
@@ -450,6 +682,7 @@ uint8_t isd17xx_get_status(isd17xx_handle_t *handle, uint16_t *status1, uint8_t
 {
     uint8_t buf[3];
     uint8_t status[3];
+    uint64_t age;
 
     if (handle == NULL)                                                                   /* check handle */
     {
@@ -460,6 +693,20 @@ uint8_t isd17xx_get_status(isd17xx_handle_t *handle, uint16_t *status1, uint8_t
         return 3;                                                                         /* return error */
     }
 
+    if ((handle->status_max_age != 0) && (handle->get_time_us != NULL))                   /* check the cache */
+    {
+        age = handle->get_time_us() - handle->status_cache_time;                          /* get the cache age */
+        if ((handle->status_cache_valid != 0) && (age <= handle->status_max_age))         /* check the age */
+        {
+            *status1 = handle->status1_cache;                                             /* get the cached status1 */
+            *status2 = handle->status2_cache;                                             /* get the cached status2 */
+            handle->status_cache_hit++;                                                   /* hit */
+
+            return 0;                                                                     /* success return 0 */
+        }
+        handle->status_cache_miss++;                                                      /* miss */
+    }
+
     buf[0] = ISD17XX_COMMAND_RD_STATUS;                                                   /* set read status command */
     buf[1] = 0x00;                                                                        /* set 0x00 */
     buf[2] = 0x00;                                                                        /* set 0x00 */
@@ -484,11 +731,78 @@ uint8_t isd17xx_get_status(isd17xx_handle_t *handle, uint16_t *status1, uint8_t
                 return 1;                                                                 /* return error */
             }
         }
+        a_isd17xx_status_cache_store(handle, *status1 &
+                                     (uint16_t)(~(ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)),
+                                     *status2);                                           /* the interrupt is cleared */
 
         return 0;                                                                         /* success return 0 */
     }
 }
 
+/**
+ * @brief      read the status and both points
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the three frames share one bus transaction when spi_transmit_vector is linked,
+ *             the interrupt is cleared like get status
+ */
+uint8_t isd17xx_read_snapshot(isd17xx_handle_t *handle, isd17xx_snapshot_t *snapshot)
+{
+    uint8_t buf[3][4];
+    uint8_t data[3][4];
+    isd17xx_spi_segment_t seg[3];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    memset(buf, 0, sizeof(buf));                                                          /* clear the buffer */
+    buf[0][0] = ISD17XX_COMMAND_RD_STATUS;                                                /* set read status command */
+    buf[1][0] = ISD17XX_COMMAND_RD_PLAY_PTR;                                              /* read play point command */
+    buf[2][0] = ISD17XX_COMMAND_RD_REC_PTR;                                               /* read record point command */
+    seg[0].tx = buf[0];                                                                   /* set the status tx */
+    seg[0].rx = data[0];                                                                  /* set the status rx */
+    seg[0].len = 3;                                                                       /* set 3 */
+    seg[1].tx = buf[1];                                                                   /* set the play point tx */
+    seg[1].rx = data[1];                                                                  /* set the play point rx */
+    seg[1].len = 4;                                                                       /* set 4 */
+    seg[2].tx = buf[2];                                                                   /* set the record point tx */
+    seg[2].rx = data[2];                                                                  /* set the record point rx */
+    seg[2].len = 4;                                                                       /* set 4 */
+    if (a_isd17xx_spi_transmit_vector(handle, seg, 3) != 0)                               /* read all */
+    {
+        handle->debug_print("isd17xx: read snapshot failed.\n");                          /* read snapshot failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    snapshot->status1 = ((uint16_t)data[0][0]) << 8 | data[0][1];                         /* set the status1 */
+    snapshot->status2 = data[0][2];                                                       /* set the status2 */
+    snapshot->play_point = (uint16_t)(data[1][3] & 0x7) << 8 | data[1][2];                /* set the play point */
+    snapshot->record_point = (uint16_t)(data[2][3] & 0x7) << 8 | data[2][2];              /* set the record point */
+    if ((snapshot->status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)           /* check the eom and int */
+    {
+        buf[0][0] = 0x00;                                                                 /* set 0x00 */
+        if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_CLR_INT, buf[0], 1) != 0)         /* set clear interrupt */
+        {
+            handle->debug_print("isd17xx: set clear interrupt failed.\n");                /* set clear interrupt failed */
+            
+            return 1;                                                                     /* return error */
+        }
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
 /**
  * @brief     power down
  * @param[in] *handle pointer to an isd17xx handle structure
@@ -599,7 +913,7 @@ uint8_t isd17xx_play(isd17xx_handle_t *handle)
     }
     else
     {
-        handle->delay_ms(500);                                                 /* delay 500ms */
+        a_isd17xx_command_delay(handle);                                       /* command delay */
 
         return 0;                                                              /* success return 0 */
     }
@@ -628,6 +942,7 @@ uint8_t isd17xx_record(isd17xx_handle_t *handle)
         return 3;                                                             /* return error */
     }
 
+    handle->message_index_valid = 0;                                          /* invalidate the message index */
     buf[0] = 0x00;                                                            /* set 0x00 */
     if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_REC, buf, 1) != 0)        /* set record */
     {
@@ -637,7 +952,7 @@ uint8_t isd17xx_record(isd17xx_handle_t *handle)
     }
     else
     {
-        handle->delay_ms(500);                                                /* delay 500ms */
+        a_isd17xx_command_delay(handle);                                      /* command delay */
 
         return 0;                                                             /* success return 0 */
     }
@@ -666,6 +981,7 @@ uint8_t isd17xx_erase(isd17xx_handle_t *handle)
         return 3;                                                               /* return error */
     }
 
+    handle->message_index_valid = 0;                                            /* invalidate the message index */
     buf[0] = 0x00;                                                              /* set 0x00 */
     if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_ERASE, buf, 1) != 0)        /* set erase */
     {
@@ -675,7 +991,7 @@ uint8_t isd17xx_erase(isd17xx_handle_t *handle)
     }
     else
     {
-        handle->delay_ms(500);                                                  /* delay 500ms */
+        a_isd17xx_command_delay(handle);                                        /* command delay */
 
         return 0;                                                               /* success return 0 */
     }
@@ -704,6 +1020,7 @@ uint8_t isd17xx_global_erase(isd17xx_handle_t *handle)
         return 3;                                                                 /* return error */
     }
 
+    handle->message_index_valid = 0;                                              /* invalidate the message index */
     buf[0] = 0x00;                                                                /* set 0x00 */
     if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_G_ERASE, buf, 1) != 0)        /* set global erase */
     {
@@ -713,7 +1030,7 @@ uint8_t isd17xx_global_erase(isd17xx_handle_t *handle)
     }
     else
     {
-        handle->delay_ms(500);                                                    /* delay 500ms */
+        a_isd17xx_command_delay(handle);                                          /* command delay */
 
         return 0;                                                                 /* success return 0 */
     }
@@ -751,7 +1068,7 @@ uint8_t isd17xx_next(isd17xx_handle_t *handle)
     }
     else
     {
-        handle->delay_ms(500);                                                /* delay 500ms */
+        a_isd17xx_command_delay(handle);                                      /* command delay */
 
         return 0;                                                             /* success return 0 */
     }
@@ -880,39 +1197,41 @@ uint8_t isd17xx_read_record_point(isd17xx_handle_t *handle, uint16_t *point)
 }
 
 /**
- * @brief     set the volume
- * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] vol set volume
- * @return    status code
- *            - 0 success
- *            - 1 set volume failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 vol is over 7
- * @note      -4dB per step volume adjustment
- *            0 is max and 7 is min
+ * @brief isd17xx apc field descriptor table definition
  */
-uint8_t isd17xx_set_volume(isd17xx_handle_t *handle, uint8_t vol)
+static const struct
+{
+    uint8_t shift;         /**< bit shift */
+    uint8_t width;         /**< bit width */
+    uint8_t invert;        /**< active low flag */
+} gsc_isd17xx_apc_field[] =
+{
+    {0,  3, 0},            /**< volume */
+    {3,  1, 0},            /**< monitor input */
+    {4,  1, 0},            /**< mix input */
+    {5,  1, 1},            /**< sound effect editing */
+    {6,  1, 1},            /**< spi ft */
+    {7,  1, 0},            /**< analog output */
+    {8,  1, 1},            /**< pwm speaker */
+    {9,  1, 1},            /**< power up analog output */
+    {10, 1, 1},            /**< v alert */
+    {11, 1, 0},            /**< eom */
+};
+
+/**
+ * @brief      read the apc register
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *config pointer to a config buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_apc_read(isd17xx_handle_t *handle, uint16_t *config)
 {
     uint8_t buf[4];
     uint8_t data[4];
-    uint8_t config;
-
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
-    {
-        return 3;                                                         /* return error */
-    }
-    if (vol > 0x7)                                                        /* check the vol */
-    {
-        handle->debug_print("isd17xx: vol is over 7.\n");                 /* vol is over 7 */
-
-        return 4;                                                         /* return error */
-    }
-
+    
     buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
     buf[1] = 0x00;                                                        /* set 0x00 */
     buf[2] = 0x00;                                                        /* set 0x00 */
@@ -920,17 +1239,28 @@ uint8_t isd17xx_set_volume(isd17xx_handle_t *handle, uint8_t vol)
     if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
     {
         handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
+        
         return 1;                                                         /* return error */
     }
+    *config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                   /* get the config */
+    
+    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+}
 
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~0x7;                                                       /* clear config */
-    config |= vol;                                                        /* set the vol */
+/**
+ * @brief     write the apc register
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] config apc register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_apc_write(isd17xx_handle_t *handle, uint16_t config)
+{
+    uint8_t buf[3];
+    uint8_t data[3];
+    
     if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
     {
         buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
@@ -940,182 +1270,161 @@ uint8_t isd17xx_set_volume(isd17xx_handle_t *handle, uint8_t vol)
         buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
     }
     buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = ((uint16_t)config >> 8) & 0xFF;                              /* set high */
+    buf[2] = (config >> 8) & 0x0F;                                        /* set high */
     if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
     {
         handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
+        
         return 1;                                                         /* return error */
     }
-
+    
     return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
 }
 
 /**
- * @brief      get the volume
- * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *vol pointer to a volume buffer
- * @return     status code
- *             - 0 success
- *             - 1 get volume failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief         encode an apc field
+ * @param[in,out] *config pointer to an apc register value
+ * @param[in]     field apc field
+ * @param[in]     value field value
+ * @return        status code
+ *                - 0 success
+ *                - 2 config is NULL
+ *                - 4 field is invalid
+ *                - 5 value is invalid
+ * @note          value is the logical value, active low bits are inverted inside, no bus access
  */
-uint8_t isd17xx_get_volume(isd17xx_handle_t *handle, uint8_t *vol)
+uint8_t isd17xx_apc_encode_field(uint16_t *config, isd17xx_apc_field_t field, uint8_t value)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
+    uint16_t mask;
+    
+    if (config == NULL)                                                  /* check config */
     {
-        return 2;                                                         /* return error */
+        return 2;                                                        /* return error */
     }
-    if (handle->inited != 1)                                              /* check handle initialization */
+    if ((uint8_t)field >= ISD17XX_APC_FIELD_NUM)                         /* check the field */
     {
-        return 3;                                                         /* return error */
+        return 4;                                                        /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
+    mask = (uint16_t)((1 << gsc_isd17xx_apc_field[field].width) - 1);    /* get the mask */
+    if (value > mask)                                                    /* check the value */
     {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
+        return 5;                                                        /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    *vol = config & 0x7;                                                  /* get the volume */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    
+    if (gsc_isd17xx_apc_field[field].invert != 0)                        /* active low */
+    {
+        value = (~value) & mask;                                         /* invert the value */
+    }
+    *config &= ~(mask << gsc_isd17xx_apc_field[field].shift);            /* clear config */
+    *config |= (uint16_t)value << gsc_isd17xx_apc_field[field].shift;    /* set the config */
+    
+    return 0;                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the monitor input
- * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set monitor input failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      decode an apc field
+ * @param[in]  config apc register value
+ * @param[in]  field apc field
+ * @param[out] *value pointer to a field value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 value is NULL
+ *             - 4 field is invalid
+ * @note       value is the logical value, active low bits are inverted inside, no bus access
  */
-uint8_t isd17xx_set_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_apc_decode_field(uint16_t config, isd17xx_apc_field_t field, uint8_t *value)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
-    {
-        return 3;                                                         /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
-        return 1;                                                         /* return error */
-    }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~(1 << 3);                                                  /* clear config */
-    config |= enable << 3;                                                /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
+    uint16_t mask;
+    
+    if (value == NULL)                                                               /* check value */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
+        return 2;                                                                    /* return error */
     }
-    else                                                                  /* register control */
+    if ((uint8_t)field >= ISD17XX_APC_FIELD_NUM)                                     /* check the field */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        return 4;                                                                    /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    
+    mask = (uint16_t)((1 << gsc_isd17xx_apc_field[field].width) - 1);                /* get the mask */
+    *value = (uint8_t)((config >> gsc_isd17xx_apc_field[field].shift) & mask);       /* get the value */
+    if (gsc_isd17xx_apc_field[field].invert != 0)                                    /* active low */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
+        *value = (~(*value)) & mask;                                                 /* invert the value */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      get the monitor input status
+ * @brief      read the whole apc register
  * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *config pointer to an apc register buffer
  * @return     status code
  *             - 0 success
- *             - 1 get monitor input failed
+ *             - 1 read apc failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       one read apc frame, decode it with isd17xx_apc_decode_field
  */
-uint8_t isd17xx_get_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_apc_read(isd17xx_handle_t *handle, uint16_t *config)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
+    if (handle == NULL)                              /* check handle */
     {
-        return 2;                                                     /* return error */
+        return 2;                                    /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle->inited != 1)                         /* check handle initialization */
     {
-        return 3;                                                     /* return error */
+        return 3;                                    /* return error */
     }
+    
+    return a_isd17xx_apc_read(handle, config);       /* read the config */
+}
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+/**
+ * @brief     write the whole apc register
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] config apc register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write apc failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      one write apc frame, all fields change at once,
+ *            build the value with isd17xx_apc_encode_field
+ */
+uint8_t isd17xx_apc_write(isd17xx_handle_t *handle, uint16_t config)
+{
+    if (handle == NULL)                              /* check handle */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        return 2;                                    /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)((config >> 3) & 0x01);                 /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    if (handle->inited != 1)                         /* check handle initialization */
+    {
+        return 3;                                    /* return error */
+    }
+    
+    return a_isd17xx_apc_write(handle, config);      /* write the config */
 }
 
 /**
- * @brief     enable or disable the mix input
+ * @brief     set an apc field
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] enable bool value
+ * @param[in] field apc field
+ * @param[in] value field value
  * @return    status code
  *            - 0 success
- *            - 1 set mix input failed
+ *            - 1 set apc field failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 field is invalid
+ *            - 5 value is invalid
+ * @note      value is the logical value, active low bits are inverted inside
  */
-uint8_t isd17xx_set_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_apc_set_field(isd17xx_handle_t *handle, isd17xx_apc_field_t field, uint8_t value)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
+    uint8_t res;
     uint16_t config;
-
+    
     if (handle == NULL)                                                   /* check handle */
     {
         return 2;                                                         /* return error */
@@ -1124,255 +1433,263 @@ uint8_t isd17xx_set_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t enable)
     {
         return 3;                                                         /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
-        return 1;                                                         /* return error */
-    }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~(1 << 4);                                                  /* clear config */
-    config |= enable << 4;                                                /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
-    }
-    else                                                                  /* register control */
+    config = 0;                                                           /* init 0 */
+    res = isd17xx_apc_encode_field(&config, field, value);                /* check the field and value */
+    if (res != 0)                                                         /* check the result */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        handle->debug_print("isd17xx: field or value is invalid.\n");     /* field or value is invalid */
+        
+        return res;                                                       /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    
+    if (a_isd17xx_apc_read(handle, &config) != 0)                         /* read the config */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
         return 1;                                                         /* return error */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    (void)isd17xx_apc_encode_field(&config, field, value);                /* set the field */
+    
+    return a_isd17xx_apc_write(handle, config);                           /* write the config */
 }
 
 /**
- * @brief      get the mix input status
+ * @brief      get an apc field
  * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[in]  field apc field
+ * @param[out] *value pointer to a field value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get mix input failed
+ *             - 1 get apc field failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 field is invalid
+ * @note       value is the logical value, active low bits are inverted inside
  */
-uint8_t isd17xx_get_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_apc_get_field(isd17xx_handle_t *handle, isd17xx_apc_field_t field, uint8_t *value)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
     uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
+    
+    if (handle == NULL)                                                   /* check handle */
     {
-        return 2;                                                     /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        return 3;                                                     /* return error */
+        return 3;                                                         /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    if ((uint8_t)field >= ISD17XX_APC_FIELD_NUM)                          /* check the field */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        handle->debug_print("isd17xx: field is invalid.\n");              /* field is invalid */
+        
+        return 4;                                                         /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)((config >> 4) & 0x01);                 /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    if (a_isd17xx_apc_read(handle, &config) != 0)                         /* read the config */
+    {
+        return 1;                                                         /* return error */
+    }
+    
+    return isd17xx_apc_decode_field(config, field, value);                /* get the value */
 }
 
 /**
- * @brief     enable or disable sound effect editing
+ * @brief     set the volume
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] enable bool value
+ * @param[in] vol set volume
  * @return    status code
  *            - 0 success
- *            - 1 set sound effect editing failed
+ *            - 1 set volume failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 vol is over 7
+ * @note      -4dB per step volume adjustment
+ *            0 is max and 7 is min
  */
-uint8_t isd17xx_set_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_set_volume(isd17xx_handle_t *handle, uint8_t vol)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
-    {
-        return 3;                                                         /* return error */
+        return 2;                                                                     /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
+        return 3;                                                                     /* return error */
     }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
+    if (vol > 0x7)                                                                    /* check the vol */
     {
-        return 1;                                                         /* return error */
+        handle->debug_print("isd17xx: vol is over 7.\n");                             /* vol is over 7 */
+        
+        return 4;                                                                     /* return error */
     }
+    
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_VOLUME, vol);              /* set the field */
+}
 
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~(1 << 5);                                                  /* clear config */
-    config |= (!enable) << 5;                                             /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
-    }
-    else                                                                  /* register control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
-    }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+/**
+ * @brief      get the volume
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *vol pointer to a volume buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get volume failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_volume(isd17xx_handle_t *handle, uint8_t *vol)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_VOLUME, &value);        /* get the field */
+    if (res == 0)                                                                 /* check the result */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
+        *vol = value;                                                             /* set the value */
     }
+    
+    return res;                                                                   /* return the result */
+}
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+/**
+ * @brief     enable or disable the monitor input
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set monitor input failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 enable is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+{
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_MONITOR_INPUT, (uint8_t)enable);        /* set the field */
 }
 
 /**
- * @brief      get the sound effect editing status
+ * @brief      get the monitor input status
  * @param[in]  *handle pointer to an isd17xx handle structure
  * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get sound effect editing failed
+ *             - 1 get monitor input failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t isd17xx_get_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_get_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
-    {
-        return 2;                                                     /* return error */
-    }
-    if (handle->inited != 1)                                          /* check handle initialization */
-    {
-        return 3;                                                     /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_MONITOR_INPUT, &value);        /* get the field */
+    if (res == 0)                                                                        /* check the result */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        *enable = (isd17xx_bool_t)(value);                                               /* set the value */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)(!((config >> 5) & 0x01));              /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    return res;                                                                          /* return the result */
 }
 
 /**
- * @brief     enable or disable spi ft
+ * @brief     enable or disable the mix input
  * @param[in] *handle pointer to an isd17xx handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set spi ft failed
+ *            - 1 set mix input failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
-uint8_t isd17xx_set_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_set_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_MIX_INPUT, (uint8_t)enable);        /* set the field */
+}
 
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
+/**
+ * @brief      get the mix input status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get mix input failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_MIX_INPUT, &value);        /* get the field */
+    if (res == 0)                                                                    /* check the result */
     {
-        return 3;                                                         /* return error */
+        *enable = (isd17xx_bool_t)(value);                                           /* set the value */
     }
+    
+    return res;                                                                      /* return the result */
+}
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
-        return 1;                                                         /* return error */
-    }
+/**
+ * @brief     enable or disable sound effect editing
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set sound effect editing failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 enable is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+{
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_SOUND_EFFECT_EDITING, (uint8_t)enable);        /* set the field */
+}
 
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~(1 << 6);                                                  /* clear config */
-    config |= (!enable) << 6;                                             /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
-    }
-    else                                                                  /* register control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
-    }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+/**
+ * @brief      get the sound effect editing status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sound effect editing failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_SOUND_EFFECT_EDITING, &value);        /* get the field */
+    if (res == 0)                                                                               /* check the result */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
+        *enable = (isd17xx_bool_t)(value);                                                      /* set the value */
     }
+    
+    return res;                                                                                 /* return the result */
+}
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+/**
+ * @brief     enable or disable spi ft
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set spi ft failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 enable is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+{
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_SPI_FT, (uint8_t)enable);        /* set the field */
 }
 
 /**
@@ -1388,33 +1705,16 @@ uint8_t isd17xx_set_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t enable)
  */
 uint8_t isd17xx_get_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
-    {
-        return 2;                                                     /* return error */
-    }
-    if (handle->inited != 1)                                          /* check handle initialization */
-    {
-        return 3;                                                     /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_SPI_FT, &value);        /* get the field */
+    if (res == 0)                                                                 /* check the result */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        *enable = (isd17xx_bool_t)(value);                                        /* set the value */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)(!((config >> 6) & 0x01));              /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    return res;                                                                   /* return the result */
 }
 
 /**
@@ -1426,59 +1726,12 @@ uint8_t isd17xx_get_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
  *            - 1 set analog output failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 output is invalid
  * @note      none
  */
 uint8_t isd17xx_set_analog_output(isd17xx_handle_t *handle, isd17xx_analog_output_t output)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
-    {
-        return 3;                                                         /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
-        return 1;                                                         /* return error */
-    }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~(1 << 7);                                                  /* clear config */
-    config |= output << 7;                                                /* set the output */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
-    }
-    else                                                                  /* register control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
-    }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
-    {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
-    }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_ANALOG_OUTPUT, (uint8_t)output);        /* set the field */
 }
 
 /**
@@ -1494,33 +1747,16 @@ uint8_t isd17xx_set_analog_output(isd17xx_handle_t *handle, isd17xx_analog_outpu
  */
 uint8_t isd17xx_get_analog_output(isd17xx_handle_t *handle, isd17xx_analog_output_t *output)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
-    {
-        return 2;                                                     /* return error */
-    }
-    if (handle->inited != 1)                                          /* check handle initialization */
-    {
-        return 3;                                                     /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_ANALOG_OUTPUT, &value);        /* get the field */
+    if (res == 0)                                                                        /* check the result */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        *output = (isd17xx_analog_output_t)(value);                                      /* set the value */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *output = (isd17xx_analog_output_t)((config >> 7) & 0x01);        /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    return res;                                                                          /* return the result */
 }
 
 /**
@@ -1532,59 +1768,12 @@ uint8_t isd17xx_get_analog_output(isd17xx_handle_t *handle, isd17xx_analog_outpu
  *            - 1 set pwm speaker failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
-    {
-        return 3;                                                         /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
-    {
-        return 1;                                                         /* return error */
-    }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~((uint16_t)1 << 8);                                        /* clear config */
-    config |= (!enable) << 8;                                             /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
-    }
-    else                                                                  /* register control */
-    {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
-    }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
-    {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
-    }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_PWM_SPEAKER, (uint8_t)enable);        /* set the field */
 }
 
 /**
@@ -1600,33 +1789,16 @@ uint8_t isd17xx_set_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t enable)
  */
 uint8_t isd17xx_get_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
-    {
-        return 2;                                                     /* return error */
-    }
-    if (handle->inited != 1)                                          /* check handle initialization */
-    {
-        return 3;                                                     /* return error */
-    }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_PWM_SPEAKER, &value);        /* get the field */
+    if (res == 0)                                                                      /* check the result */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        *enable = (isd17xx_bool_t)(value);                                             /* set the value */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)(!((config >> 8) & 0x01));              /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    return res;                                                                        /* return the result */
 }
 
 /**
@@ -1638,546 +1810,840 @@ uint8_t isd17xx_get_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t *enable
  *            - 1 set power up analog output failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_power_up_analog_output(isd17xx_handle_t *handle, isd17xx_bool_t enable)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_POWER_UP_ANALOG_OUTPUT, (uint8_t)enable);        /* set the field */
+}
 
-    if (handle == NULL)                                                   /* check handle */
-    {
-        return 2;                                                         /* return error */
-    }
-    if (handle->inited != 1)                                              /* check handle initialization */
+/**
+ * @brief      get the power up analog output status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get power up analog output failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_power_up_analog_output(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_POWER_UP_ANALOG_OUTPUT, &value);        /* get the field */
+    if (res == 0)                                                                                 /* check the result */
     {
-        return 3;                                                         /* return error */
+        *enable = (isd17xx_bool_t)(value);                                                        /* set the value */
     }
+    
+    return res;                                                                                   /* return the result */
+}
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
-    {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
+/**
+ * @brief     enable or disable v alert
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set v alert failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 enable is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+{
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_V_ALERT, (uint8_t)enable);        /* set the field */
+}
 
-        return 1;                                                         /* return error */
-    }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
+/**
+ * @brief      get the v alert status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get v alert failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_V_ALERT, &value);        /* get the field */
+    if (res == 0)                                                                  /* check the result */
     {
-        return 1;                                                         /* return error */
+        *enable = (isd17xx_bool_t)(value);                                         /* set the value */
     }
+    
+    return res;                                                                    /* return the result */
+}
 
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~((uint16_t)1 << 9);                                        /* clear config */
-    config |= (!enable) << 9;                                             /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
+/**
+ * @brief     enable or disable eom stop playing
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set eom failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 enable is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_eom(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+{
+    return isd17xx_apc_set_field(handle, ISD17XX_APC_FIELD_EOM, (uint8_t)enable);        /* set the field */
+}
+
+/**
+ * @brief      get the eom status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get eom failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_eom(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t value;
+    
+    res = isd17xx_apc_get_field(handle, ISD17XX_APC_FIELD_EOM, &value);        /* get the field */
+    if (res == 0)                                                              /* check the result */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
+        *enable = (isd17xx_bool_t)(value);                                     /* set the value */
     }
-    else                                                                  /* register control */
+    
+    return res;                                                                /* return the result */
+}
+
+/**
+ * @brief     set the volume control type
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] control volume control type
+ * @return    status code
+ *            - 0 success
+ *            - 1 set volume control failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_set_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control_t control)
+{
+    uint16_t config;
+
+    if (handle == NULL)                                                   /* check handle */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        return 2;                                                         /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
+        return 3;                                                         /* return error */
+    }
 
+    if (a_isd17xx_apc_read(handle, &config) != 0)                         /* read the apc */
+    {
         return 1;                                                         /* return error */
     }
+    handle->vol_control = control;                                        /* set vol control */
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    return a_isd17xx_apc_write(handle, config);                           /* write the apc with the new control */
 }
 
 /**
- * @brief      get the power up analog output status
+ * @brief      get the volume control type
  * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *control pointer to a volume control type buffer
  * @return     status code
  *             - 0 success
- *             - 1 get power up analog output failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t isd17xx_get_power_up_analog_output(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_get_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control_t *control)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
 
-    if (handle == NULL)                                               /* check handle */
+    *control = (isd17xx_vol_control_t)(handle->vol_control);        /* get the vol control */
+
+    return a_isd17xx_check_status(handle, 0, 0, 0, 0);              /* check the status */
+}
+
+/**
+ * @brief     write config to non volatile memory
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write to nvc failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_write_to_nv(isd17xx_handle_t *handle)
+{
+    uint8_t buf[1];
+
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                     /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                     /* return error */
+        return 3;                                                                  /* return error */
     }
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    buf[0] = 0x00;                                                                 /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_WR_NVCFG, buf, 1) != 0)        /* set write to nvc */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
+        handle->debug_print("isd17xx: set write to nvc failed.\n");                /* set write to nvc failed */
 
-        return 1;                                                     /* return error */
+        return 1;                                                                  /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)(!((config >> 9) & 0x01));              /* get the bool */
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                             /* check the status */
 }
 
 /**
- * @brief     enable or disable v alert
+ * @brief     load config from non volatile memory
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set v alert failed
+ *            - 1 load from nvc failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t isd17xx_set_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_load_from_nv(isd17xx_handle_t *handle)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    uint8_t buf[1];
 
-    if (handle == NULL)                                                   /* check handle */
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                         /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                              /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                         /* return error */
+        return 3;                                                                  /* return error */
     }
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
+    buf[0] = 0x00;                                                                 /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_LD_NVCFG, buf, 1) != 0)        /* set load from nvc */
     {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
+        handle->debug_print("isd17xx: set load from nvc failed.\n");               /* set load from nvc failed */
 
-        return 1;                                                         /* return error */
+        return 1;                                                                  /* return error */
     }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
+
+    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                             /* check the status */
+}
+
+/**
+ * @brief     set the play point
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 start_addr >= end_addr
+ *            - 5 address is invalid
+ * @note      none
+ */
+uint8_t isd17xx_set_play(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+{
+    uint8_t buf[6];
+
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 1;                                                         /* return error */
+        return 2;                                                                  /* return error */
     }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~((uint16_t)1 << 10);                                       /* clear config */
-    config |= (!enable) << 10;                                            /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
+        return 3;                                                                  /* return error */
     }
-    else                                                                  /* register control */
+    if (start_addr >= end_addr)                                                    /* check the address */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                 /* start_addr >= end_addr */
+
+        return 4;                                                                  /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    if (end_addr > handle->end_address)                                            /* check the address */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
+        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
 
-        return 1;                                                         /* return error */
+        return 5;                                                                  /* return error */
     }
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    buf[0] = 0x00;                                                                 /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                    /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                             /* set start address*/
+    buf[3] = end_addr & 0xFF;                                                      /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                               /* set end address */
+    buf[5] = 0x00;                                                                 /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_PLAY, buf, 6) != 0)        /* set play */
+    {
+        handle->debug_print("isd17xx: set play failed.\n");                        /* set play failed */
+
+        return 1;                                                                  /* return error */
+    }
+    a_isd17xx_command_delay(handle);                                               /* command delay */
+
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get the v alert status
- * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get v alert failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     set the record point
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set record failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 start_addr >= end_addr
+ *            - 5 address is invalid
+ * @note      none
  */
-uint8_t isd17xx_get_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_set_record(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    uint8_t buf[6];
 
-    if (handle == NULL)                                               /* check handle */
+    if (handle == NULL)                                                           /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if (start_addr >= end_addr)                                                   /* check the address */
     {
-        return 2;                                                     /* return error */
+        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                /* start_addr >= end_addr */
+
+        return 4;                                                                 /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (end_addr > handle->end_address)                                            /* check the address */
     {
-        return 3;                                                     /* return error */
+        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
+
+        return 5;                                                                  /* return error */
     }
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    handle->message_index_valid = 0;                                              /* invalidate the message index */
+    buf[0] = 0x00;                                                                /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                   /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                            /* set start address */
+    buf[3] = end_addr & 0xFF;                                                     /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                              /* set end address */
+    buf[5] = 0x00;                                                                /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_REC, buf, 6) != 0)        /* set record */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
+        handle->debug_print("isd17xx: set record failed.\n");                     /* set record failed */
 
-        return 1;                                                     /* return error */
+        return 1;                                                                 /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)(!((config >> 10) & 0x01));             /* get the bool */
+    a_isd17xx_command_delay(handle);                                              /* command delay */
 
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief     enable or disable eom stop playing
+ * @brief     set the erase point
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] enable bool value
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
  * @return    status code
  *            - 0 success
- *            - 1 set eom failed
+ *            - 1 set erase failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 start_addr >= end_addr
+ *            - 5 address is invalid
  * @note      none
  */
-uint8_t isd17xx_set_eom(isd17xx_handle_t *handle, isd17xx_bool_t enable)
+uint8_t isd17xx_set_erase(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
+    uint8_t buf[6];
 
-    if (handle == NULL)                                                   /* check handle */
+    if (handle == NULL)                                                           /* check handle */
     {
-        return 2;                                                         /* return error */
+        return 2;                                                                 /* return error */
     }
-    if (handle->inited != 1)                                              /* check handle initialization */
+    if (handle->inited != 1)                                                      /* check handle initialization */
     {
-        return 3;                                                         /* return error */
+        return 3;                                                                 /* return error */
     }
+    if (start_addr >= end_addr)                                                   /* check the address */
+    {
+        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                /* start_addr >= end_addr */
 
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
+        return 4;                                                                 /* return error */
+    }
+    if (end_addr > handle->end_address)                                            /* check the address */
     {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
+        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
 
-        return 1;                                                         /* return error */
+        return 5;                                                                  /* return error */
     }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
+
+    handle->message_index_valid = 0;                                              /* invalidate the message index */
+    buf[0] = 0x00;                                                                /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                   /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                            /* set start address */
+    buf[3] = end_addr & 0xFF;                                                     /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                              /* set end address */
+    buf[5] = 0x00;                                                                /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_ERASE, buf, 6) != 0)      /* set erase */
     {
-        return 1;                                                         /* return error */
+        handle->debug_print("isd17xx: set erase failed.\n");                      /* set erase failed */
+
+        return 1;                                                                 /* return error */
     }
+    a_isd17xx_command_delay(handle);                                              /* command delay */
 
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    config &= ~((uint16_t)1 << 11);                                       /* clear config */
-    config |= enable << 11;                                               /* set the config */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     toggle the enable and disable of the external clock
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 toggle extern clock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_toggle_extern_clock(isd17xx_handle_t *handle)
+{
+    uint8_t buf[1];
+
+    if (handle == NULL)                                                          /* check handle */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
+        return 2;                                                                /* return error */
     }
-    else                                                                  /* register control */
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+
+    buf[0] = 0x00;                                                               /* set 0x00 */
+    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_EXTCLK, buf, 1) != 0)        /* set toggle */
+    {
+        handle->debug_print("isd17xx: set toggle failed.\n");                    /* set toggle failed */
+
+        return 1;                                                                /* return error */
+    }
+
+    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                           /* check the status */
+}
+
+/**
+ * @brief     set the command delay
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] ms delay in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the delay is applied after play, record, erase, global erase, next,
+ *            set play, set record and set erase, default is 500ms
+ *            0 means no delay and the caller must poll the status
+ */
+uint8_t isd17xx_set_command_delay(isd17xx_handle_t *handle, uint16_t ms)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        return 2;                       /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
+        return 3;                       /* return error */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    
+    handle->command_delay = ms;         /* set the command delay */
+    
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief      get the eom status
+ * @brief      get the command delay
  * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *ms pointer to a delay buffer
  * @return     status code
  *             - 0 success
- *             - 1 get eom failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t isd17xx_get_eom(isd17xx_handle_t *handle, isd17xx_bool_t *enable)
+uint8_t isd17xx_get_command_delay(isd17xx_handle_t *handle, uint16_t *ms)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                               /* check handle */
-    {
-        return 2;                                                     /* return error */
-    }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle == NULL)                 /* check handle */
     {
-        return 3;                                                     /* return error */
+        return 2;                       /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                  /* read apc command */
-    buf[1] = 0x00;                                                    /* set 0x00 */
-    buf[2] = 0x00;                                                    /* set 0x00 */
-    buf[3] = 0x00;                                                    /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)            /* read the data */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        handle->debug_print("isd17xx: read config failed.\n");        /* read config failed */
-
-        return 1;                                                     /* return error */
+        return 3;                       /* return error */
     }
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                /* get the config */
-    *enable = (isd17xx_bool_t)((config >> 11) & 0x01);                /* get the bool */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                /* check the status */
+    
+    *ms = handle->command_delay;        /* get the command delay */
+    
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     set the volume control type
+ * @brief     set the status cache max age
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] control volume control type
+ * @param[in] us max age in us
  * @return    status code
  *            - 0 success
- *            - 1 set volume control failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 get_time_us is NULL
+ * @note      get status is served from the cache while the last read is younger than us,
+ *            0 disables the cache and is the default
+ *            irq events and state changing commands drop the cache, so the next get status reads the chip
  */
-uint8_t isd17xx_set_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control_t control)
+uint8_t isd17xx_set_status_max_age(isd17xx_handle_t *handle, uint32_t us)
 {
-    uint8_t buf[4];
-    uint8_t data[4];
-    uint16_t config;
-
-    if (handle == NULL)                                                   /* check handle */
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                         /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                              /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                                         /* return error */
+        return 3;                                                      /* return error */
     }
-
-    buf[0] = ISD17XX_COMMAND_RD_APC;                                      /* read apc command */
-    buf[1] = 0x00;                                                        /* set 0x00 */
-    buf[2] = 0x00;                                                        /* set 0x00 */
-    buf[3] = 0x00;                                                        /* set 0x00 */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                /* read the data */
+    if ((us != 0) && (handle->get_time_us == NULL))                    /* check get_time_us */
     {
-        handle->debug_print("isd17xx: read config failed.\n");            /* read config failed */
-
-        return 1;                                                         /* return error */
+        handle->debug_print("isd17xx: get_time_us is null.\n");        /* get_time_us is null */
+        
+        return 4;                                                      /* return error */
     }
-    if (a_isd17xx_check_status(handle, 0, 0, 0, 0) != 0)                  /* check the status */
+    
+    handle->status_max_age = us;                                       /* set the max age */
+    handle->status_cache_valid = 0;                                    /* drop the cache */
+    handle->status_cache_hit = 0;                                      /* clear the hit count */
+    handle->status_cache_miss = 0;                                     /* clear the miss count */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the status cache max age
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *us pointer to a max age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_status_max_age(isd17xx_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        return 1;                                                         /* return error */
+        return 2;                       /* return error */
     }
-
-    config = (uint16_t)(data[3] & 0xF) << 8 | data[2];                    /* get the config */
-    handle->vol_control = control;                                        /* set vol control */
-    if (handle->vol_control == ISD17XX_VOL_CONTROL_BUTTON)                /* button control */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC1;                                 /* write apc command */
+        return 3;                       /* return error */
     }
-    else                                                                  /* register control */
+    
+    *us = handle->status_max_age;       /* get the max age */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get the status cache statistics
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *hit pointer to a hit count buffer
+ * @param[out] *miss pointer to a miss count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       hit rate is hit / (hit + miss), the counters are cleared when the max age is set
+ */
+uint8_t isd17xx_get_status_cache_statistics(isd17xx_handle_t *handle, uint32_t *hit, uint32_t *miss)
+{
+    if (handle == NULL)                    /* check handle */
     {
-        buf[0] = ISD17XX_COMMAND_WR_APC2;                                 /* write apc command */
+        return 2;                          /* return error */
     }
-    buf[1] = config & 0xFF;                                               /* set low */
-    buf[2] = (config >> 8) & 0xFF;                                        /* set high */
-    if (a_isd17xx_spi_transmit(handle, buf, data, 3) != 0)                /* write the data */
+    if (handle->inited != 1)               /* check handle initialization */
     {
-        handle->debug_print("isd17xx: write config failed.\n");           /* write config failed */
-
-        return 1;                                                         /* return error */
+        return 3;                          /* return error */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                    /* check the status */
+    
+    *hit = handle->status_cache_hit;       /* get the hit count */
+    *miss = handle->status_cache_miss;     /* get the miss count */
+    
+    return 0;                              /* success return 0 */
 }
 
 /**
- * @brief      get the volume control type
+ * @brief      get the driver clock
  * @param[in]  *handle pointer to an isd17xx handle structure
- * @param[out] *control pointer to a volume control type buffer
+ * @param[out] *us pointer to a time buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       get_time_us when delay_us and get_time_us are linked,
+ *             otherwise a clock only advanced by the driver delays
  */
-uint8_t isd17xx_get_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control_t *control)
+uint8_t isd17xx_get_clock(isd17xx_handle_t *handle, uint64_t *us)
 {
-    if (handle == NULL)                                             /* check handle */
+    if (handle == NULL)                   /* check handle */
     {
-        return 2;                                                   /* return error */
+        return 2;                         /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (handle->inited != 1)              /* check handle initialization */
     {
-        return 3;                                                   /* return error */
+        return 3;                         /* return error */
     }
-
-    *control = (isd17xx_vol_control_t)(handle->vol_control);        /* get the vol control */
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);              /* check the status */
+    
+    *us = a_isd17xx_clock(handle);        /* get the time */
+    
+    return 0;                             /* success return 0 */
 }
 
 /**
- * @brief     write config to non volatile memory
+ * @brief     wait until a deadline
  * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] deadline_us deadline on the driver clock in us
  * @return    status code
  *            - 0 success
- *            - 1 write to nvc failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      returns at once if the deadline has passed, so polling loops
+ *            do not drift by the bus time and the sleep overshoot
  */
-uint8_t isd17xx_write_to_nv(isd17xx_handle_t *handle)
+uint8_t isd17xx_delay_until(isd17xx_handle_t *handle, uint64_t deadline_us)
 {
-    uint8_t buf[1];
-
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                       /* return error */
     }
+    
+    a_isd17xx_delay_until(handle, deadline_us);         /* delay until the deadline */
+    
+    return 0;                                           /* success return 0 */
+}
 
-    buf[0] = 0x00;                                                                 /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_WR_NVCFG, buf, 1) != 0)        /* set write to nvc */
+/**
+ * @brief      get the delay statistics
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *count pointer to a delay count buffer
+ * @param[out] *mean_us pointer to a mean overshoot buffer
+ * @param[out] *max_us pointer to a max overshoot buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only the delay_us waits are measured, the counters are cleared by init
+ */
+uint8_t isd17xx_get_delay_statistics(isd17xx_handle_t *handle, uint32_t *count, uint32_t *mean_us, uint32_t *max_us)
+{
+    if (handle == NULL)                                                                    /* check handle */
     {
-        handle->debug_print("isd17xx: set write to nvc failed.\n");                /* set write to nvc failed */
-
-        return 1;                                                                  /* return error */
+        return 2;                                                                          /* return error */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                             /* check the status */
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    *count = handle->delay_count;                                                          /* get the delay count */
+    *mean_us = (handle->delay_count != 0) ?
+               (uint32_t)(handle->delay_overshoot_sum / handle->delay_count) : 0;          /* get the mean overshoot */
+    *max_us = handle->delay_overshoot_max;                                                 /* get the max overshoot */
+    
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     load config from non volatile memory
+ * @brief     clear the delay statistics
  * @param[in] *handle pointer to an isd17xx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 load from nvc failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t isd17xx_load_from_nv(isd17xx_handle_t *handle)
+uint8_t isd17xx_clear_delay_statistics(isd17xx_handle_t *handle)
 {
-    uint8_t buf[1];
-
-    if (handle == NULL)                                                            /* check handle */
-    {
-        return 2;                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle == NULL)                        /* check handle */
     {
-        return 3;                                                                  /* return error */
+        return 2;                              /* return error */
     }
-
-    buf[0] = 0x00;                                                                 /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_LD_NVCFG, buf, 1) != 0)        /* set load from nvc */
+    if (handle->inited != 1)                   /* check handle initialization */
     {
-        handle->debug_print("isd17xx: set load from nvc failed.\n");               /* set load from nvc failed */
-
-        return 1;                                                                  /* return error */
+        return 3;                              /* return error */
     }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                             /* check the status */
+    
+    handle->delay_count = 0;                   /* clear the delay count */
+    handle->delay_overshoot_max = 0;           /* clear the max overshoot */
+    handle->delay_overshoot_sum = 0;           /* clear the overshoot sum */
+    
+    return 0;                                  /* success return 0 */
 }
 
 /**
- * @brief     set the play point
+ * @brief     build the message index
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] start_addr start address
- * @param[in] end_addr end address
  * @return    status code
  *            - 0 success
- *            - 1 set play failed
+ *            - 1 build message index failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 start_addr >= end_addr
- *            - 5 address is invalid
- * @note      none
+ * @note      the chip must be in standby, the play point is moved
+ *            the index is dropped by init, hardware reset, set_reg,
+ *            record, erase and global erase
  */
-uint8_t isd17xx_set_play(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+uint8_t isd17xx_build_message_index(isd17xx_handle_t *handle)
 {
-    uint8_t buf[6];
-
-    if (handle == NULL)                                                            /* check handle */
+    uint8_t i;
+    uint8_t j;
+    uint8_t num;
+    uint16_t point;
+    uint16_t rec_point;
+    uint16_t command_delay;
+    
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                             /* return error */
     }
-    if (start_addr >= end_addr)                                                    /* check the address */
+    
+    handle->message_index_valid = 0;                                          /* drop the old index */
+    handle->message_num = 0;                                                  /* init 0 */
+    if (isd17xx_read_record_point(handle, &rec_point) != 0)                   /* read the record point */
     {
-        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                 /* start_addr >= end_addr */
-
-        return 4;                                                                  /* return error */
+        return 1;                                                             /* return error */
     }
-    if (end_addr > handle->end_address)                                            /* check the address */
+    if (rec_point <= ISD17XX_MESSAGE_START_ADDRESS)                           /* check the empty memory */
     {
-        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
-
-        return 5;                                                                  /* return error */
+        handle->message_index_valid = 1;                                      /* no message */
+        
+        return 0;                                                             /* success return 0 */
     }
-
-    buf[0] = 0x00;                                                                 /* set 0x00 */
-    buf[1] = start_addr & 0xFF;                                                    /* set start address */
-    buf[2] = (start_addr >> 8) & 0x07;                                             /* set start address*/
-    buf[3] = end_addr & 0xFF;                                                      /* set end address */
-    buf[4] = (end_addr >> 8) & 0x07;                                               /* set end address */
-    buf[5] = 0x00;                                                                 /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_PLAY, buf, 6) != 0)        /* set play */
+    
+    command_delay = handle->command_delay;                                    /* save the command delay */
+    handle->command_delay = 0;                                                /* poll instead of delay */
+    num = 0;                                                                  /* init 0 */
+    while (1)                                                                 /* scan all messages */
     {
-        handle->debug_print("isd17xx: set play failed.\n");                        /* set play failed */
-
-        return 1;                                                                  /* return error */
+        if (isd17xx_next(handle) != 0)                                        /* forward */
+        {
+            handle->command_delay = command_delay;                            /* restore the command delay */
+            
+            return 1;                                                         /* return error */
+        }
+        if (a_isd17xx_wait_ready(handle, ISD17XX_READY_TIMEOUT) != 0)         /* wait ready */
+        {
+            handle->command_delay = command_delay;                            /* restore the command delay */
+            
+            return 1;                                                         /* return error */
+        }
+        if (isd17xx_read_play_point(handle, &point) != 0)                     /* read the play point */
+        {
+            handle->command_delay = command_delay;                            /* restore the command delay */
+            
+            return 1;                                                         /* return error */
+        }
+        for (i = 0; i < num; i++)                                             /* check wrapped */
+        {
+            if (handle->message_start[i] == point)                            /* check the point */
+            {
+                break;                                                        /* break */
+            }
+        }
+        if (i != num)                                                         /* all messages are found */
+        {
+            break;                                                            /* break */
+        }
+        if (num >= ISD17XX_MESSAGE_INDEX_MAX)                                 /* check the max */
+        {
+            handle->debug_print("isd17xx: message index is full.\n");         /* message index is full */
+            
+            break;                                                            /* break */
+        }
+        j = num;                                                              /* insert sorted */
+        while ((j != 0) && (handle->message_start[j - 1] > point))            /* find the position */
+        {
+            handle->message_start[j] = handle->message_start[j - 1];          /* move up */
+            j--;                                                              /* j-- */
+        }
+        handle->message_start[j] = point;                                     /* set the start */
+        num++;                                                                /* num++ */
     }
-    handle->delay_ms(500);                                                         /* delay 500ms */
-
-    return 0;                                                                      /* success return 0 */
-}
-
-/**
- * @brief     set the record point
- * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] start_addr start address
- * @param[in] end_addr end address
- * @return    status code
- *            - 0 success
- *            - 1 set record failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 start_addr >= end_addr
- *            - 5 address is invalid
- * @note      none
+    handle->command_delay = command_delay;                                    /* restore the command delay */
+    
+    for (i = 0; i < num; i++)                                                 /* set the end address */
+    {
+        if (i + 1 < num)                                                      /* not the last */
+        {
+            handle->message_end[i] = handle->message_start[i + 1] - 1;        /* end before the next */
+        }
+        else if (rec_point > handle->message_start[i])                        /* the last message */
+        {
+            handle->message_end[i] = rec_point - 1;                           /* end before the record point */
+        }
+        else
+        {
+            handle->message_end[i] = handle->end_address;                     /* end of the memory */
+        }
+    }
+    handle->message_num = num;                                                /* set the message number */
+    handle->message_index_valid = 1;                                          /* flag valid */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the message number
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *num pointer to a message number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get message number failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the message index is built if it is not cached
  */
-uint8_t isd17xx_set_record(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+uint8_t isd17xx_get_message_number(isd17xx_handle_t *handle, uint8_t *num)
 {
-    uint8_t buf[6];
-
     if (handle == NULL)                                                           /* check handle */
     {
         return 2;                                                                 /* return error */
@@ -2186,54 +2652,39 @@ uint8_t isd17xx_set_record(isd17xx_handle_t *handle, uint16_t start_addr, uint16
     {
         return 3;                                                                 /* return error */
     }
-    if (start_addr >= end_addr)                                                   /* check the address */
-    {
-        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                /* start_addr >= end_addr */
-
-        return 4;                                                                 /* return error */
-    }
-    if (end_addr > handle->end_address)                                            /* check the address */
-    {
-        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
-
-        return 5;                                                                  /* return error */
-    }
-
-    buf[0] = 0x00;                                                                /* set 0x00 */
-    buf[1] = start_addr & 0xFF;                                                   /* set start address */
-    buf[2] = (start_addr >> 8) & 0x07;                                            /* set start address */
-    buf[3] = end_addr & 0xFF;                                                     /* set end address */
-    buf[4] = (end_addr >> 8) & 0x07;                                              /* set end address */
-    buf[5] = 0x00;                                                                /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_REC, buf, 6) != 0)        /* set record */
+    
+    if (handle->message_index_valid == 0)                                         /* check the cache */
     {
-        handle->debug_print("isd17xx: set record failed.\n");                     /* set record failed */
-
-        return 1;                                                                 /* return error */
+        if (isd17xx_build_message_index(handle) != 0)                             /* build the message index */
+        {
+            handle->debug_print("isd17xx: build message index failed.\n");        /* build message index failed */
+            
+            return 1;                                                             /* return error */
+        }
     }
-    handle->delay_ms(500);                                                        /* delay 500ms */
-
+    *num = handle->message_num;                                                   /* get the message number */
+    
     return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief     set the erase point
+ * @brief     play the message
  * @param[in] *handle pointer to an isd17xx handle structure
- * @param[in] start_addr start address
- * @param[in] end_addr end address
+ * @param[in] n message index
  * @return    status code
  *            - 0 success
- *            - 1 set erase failed
+ *            - 1 play message failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 start_addr >= end_addr
- *            - 5 address is invalid
- * @note      none
+ *            - 4 n is invalid
+ * @note      the message index is built if it is not cached
+ *            the message is played with one set play command,
+ *            a one row message is played to the next row
  */
-uint8_t isd17xx_set_erase(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+uint8_t isd17xx_play_message(isd17xx_handle_t *handle, uint8_t n)
 {
-    uint8_t buf[6];
-
+    uint16_t end_addr;
+    
     if (handle == NULL)                                                           /* check handle */
     {
         return 2;                                                                 /* return error */
@@ -2242,70 +2693,36 @@ uint8_t isd17xx_set_erase(isd17xx_handle_t *handle, uint16_t start_addr, uint16_
     {
         return 3;                                                                 /* return error */
     }
-    if (start_addr >= end_addr)                                                   /* check the address */
+    
+    if (handle->message_index_valid == 0)                                         /* check the cache */
     {
-        handle->debug_print("isd17xx: start_addr >= end_addr.\n");                /* start_addr >= end_addr */
-
+        if (isd17xx_build_message_index(handle) != 0)                             /* build the message index */
+        {
+            handle->debug_print("isd17xx: build message index failed.\n");        /* build message index failed */
+            
+            return 1;                                                             /* return error */
+        }
+    }
+    if (n >= handle->message_num)                                                 /* check the index */
+    {
+        handle->debug_print("isd17xx: n is invalid.\n");                          /* n is invalid */
+        
         return 4;                                                                 /* return error */
     }
-    if (end_addr > handle->end_address)                                            /* check the address */
+    end_addr = handle->message_end[n];                                            /* get the end address */
+    if ((end_addr <= handle->message_start[n]) &&
+        (handle->message_start[n] < handle->end_address))                         /* check the one row message */
     {
-        handle->debug_print("isd17xx: address is invalid.\n");                     /* address is invalid */
-
-        return 5;                                                                  /* return error */
+        end_addr = handle->message_start[n] + 1;                                  /* play to the next row */
     }
-
-    buf[0] = 0x00;                                                                /* set 0x00 */
-    buf[1] = start_addr & 0xFF;                                                   /* set start address */
-    buf[2] = (start_addr >> 8) & 0x07;                                            /* set start address */
-    buf[3] = end_addr & 0xFF;                                                     /* set end address */
-    buf[4] = (end_addr >> 8) & 0x07;                                              /* set end address */
-    buf[5] = 0x00;                                                                /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_SET_ERASE, buf, 6) != 0)      /* set erase */
+    if (isd17xx_set_play(handle, handle->message_start[n], end_addr) != 0)        /* set play */
     {
-        handle->debug_print("isd17xx: set erase failed.\n");                      /* set erase failed */
-
         return 1;                                                                 /* return error */
     }
-    handle->delay_ms(500);                                                        /* delay 500ms */
-
+    
     return 0;                                                                     /* success return 0 */
 }
 
-/**
- * @brief     toggle the enable and disable of the external clock
- * @param[in] *handle pointer to an isd17xx handle structure
- * @return    status code
- *            - 0 success
- *            - 1 toggle extern clock failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t isd17xx_toggle_extern_clock(isd17xx_handle_t *handle)
-{
-    uint8_t buf[1];
-
-    if (handle == NULL)                                                          /* check handle */
-    {
-        return 2;                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                     /* check handle initialization */
-    {
-        return 3;                                                                /* return error */
-    }
-
-    buf[0] = 0x00;                                                               /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_EXTCLK, buf, 1) != 0)        /* set toggle */
-    {
-        handle->debug_print("isd17xx: set toggle failed.\n");                    /* set toggle failed */
-
-        return 1;                                                                /* return error */
-    }
-
-    return a_isd17xx_check_status(handle, 0, 0, 0, 0);                           /* check the status */
-}
-
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an isd17xx handle structure
@@ -2405,10 +2822,15 @@ uint8_t isd17xx_init(isd17xx_handle_t *handle)
         return 1;                                                       /* return error */
     }
     
+    handle->clock_us = 0;                                               /* reset the clock */
+    handle->delay_count = 0;                                            /* clear the delay count */
+    handle->delay_overshoot_max = 0;                                    /* clear the max overshoot */
+    handle->delay_overshoot_sum = 0;                                    /* clear the overshoot sum */
+    handle->frame_count = 0;                                            /* clear the frame count */
     handle->gpio_reset_write(1);                                        /* set high */
-    handle->delay_ms(1);                                                /* delay 1ms */
+    a_isd17xx_delay_ms(handle, 1);                                      /* delay 1ms */
     handle->gpio_reset_write(0);                                        /* set low */
-    handle->delay_ms(1);                                                /* delay 1ms */
+    a_isd17xx_delay_ms(handle, 1);                                      /* delay 1ms */
     
     buf[0] = 0x00;                                                      /* set 0x00 */
     if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_PU,
@@ -2544,6 +2966,13 @@ uint8_t isd17xx_init(isd17xx_handle_t *handle)
         return 1;                                                       /* return error */
     }
     handle->vol_control = ISD17XX_VOL_CONTROL_REG;                      /* register control */
+    handle->command_delay = ISD17XX_DEFAULT_COMMAND_DELAY;              /* set the default command delay */
+    handle->status_max_age = 0;                                         /* disable the status cache */
+    handle->status_cache_valid = 0;                                     /* no cached status */
+    handle->status_cache_hit = 0;                                       /* clear the hit count */
+    handle->status_cache_miss = 0;                                      /* clear the miss count */
+    handle->message_num = 0;                                            /* no message */
+    handle->message_index_valid = 0;                                    /* no message index */
     handle->inited = 1;                                                 /* flag finish initialization */
 
     return 0;                                                           /* success return 0 */
@@ -2609,21 +3038,24 @@ uint8_t isd17xx_deinit(isd17xx_handle_t *handle)
  */
 uint8_t isd17xx_hardware_reset(isd17xx_handle_t *handle)
 {
-    if (handle == NULL)                 /* check handle */
+    if (handle == NULL)                      /* check handle */
     {
-        return 2;                       /* return error */
+        return 2;                            /* return error */
     }
-    if (handle->inited != 1)            /* check handle initialization */
+    if (handle->inited != 1)                 /* check handle initialization */
     {
-        return 3;                       /* return error */
+        return 3;                            /* return error */
     }
     
-    handle->gpio_reset_write(1);        /* set high */
-    handle->delay_ms(1);                /* delay 1ms */
-    handle->gpio_reset_write(0);        /* set low */
-    handle->delay_ms(1);                /* delay 1ms */
+    handle->gpio_reset_write(1);             /* set high */
+    a_isd17xx_delay_ms(handle, 1);           /* delay 1ms */
+    handle->gpio_reset_write(0);             /* set low */
+    a_isd17xx_delay_ms(handle, 1);           /* delay 1ms */
+    handle->status_cache_valid = 0;          /* drop the cached status */
+    handle->message_num = 0;                 /* no message */
+    handle->message_index_valid = 0;         /* drop the message index */
     
-    return 0;                           /* success return 0 */
+    return 0;                                /* success return 0 */
 }
 
 /**
@@ -2638,51 +3070,140 @@ uint8_t isd17xx_hardware_reset(isd17xx_handle_t *handle)
  */
 uint8_t isd17xx_irq_handler(isd17xx_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t status2;
     uint16_t status1;
-    uint8_t buf[1];
+    
+    return isd17xx_irq_service(handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, NULL);        /* run the irq service */
+}
 
-    if (handle == NULL)                                                           /* check handle */
+/**
+ * @brief      irq service with the fewest spi frames
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  capture pointer capture mode
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *point pointer to a point buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 capture is invalid
+ * @note       status1 is the value before the interrupt is cleared
+ *             every spi frame returns the status1 in its first two bytes,
+ *             so the clear interrupt or point read frame doubles as the status read
+ *             without capture one clear interrupt frame is sent and point is not written
+ *             with capture the point read frame is followed by a clear interrupt frame only if eom or int is set
+ *             with spi_transmit_vector linked the point read and clear interrupt share one bus transaction
+ *             the frames carry no status2, so the status cache is dropped rather than refreshed
+ */
+uint8_t isd17xx_irq_service(isd17xx_handle_t *handle, isd17xx_irq_capture_t capture, uint16_t *status1, uint16_t *point)
+{
+    uint8_t buf[4];
+    uint8_t data[4];
+    uint8_t clear[2];
+    uint8_t clear_data[2];
+    isd17xx_spi_segment_t seg[2];
+    
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                 /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                 /* return error */
+        return 3;                                                                         /* return error */
     }
-
-    res = isd17xx_get_status(handle, &status1, &status2);                         /* get status */
-    if (res != 0)                                                                 /* check the result */
+    
+    handle->status_cache_valid = 0;                                                       /* always read the chip */
+    if (capture == ISD17XX_IRQ_CAPTURE_NONE)                                              /* status only */
     {
-        handle->debug_print("isd17xx: get status failed.\n");                     /* get status failed */
-
-        return 1;                                                                 /* return error */
+        buf[0] = ISD17XX_COMMAND_CLR_INT;                                                 /* set clear interrupt command */
+        buf[1] = 0x00;                                                                    /* set 0x00 */
+        if (a_isd17xx_spi_transmit(handle, buf, data, 2) != 0)                            /* clear interrupt and read status1 */
+        {
+            handle->debug_print("isd17xx: set clear interrupt failed.\n");                /* set clear interrupt failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        *status1 = ((uint16_t)data[0]) << 8 | data[1];                                    /* set the status1 */
     }
-    buf[0] = 0x00;                                                                /* set 0x00 */
-    if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_CLR_INT, buf, 1) != 0)        /* set clear interrupt */
+    else if ((capture == ISD17XX_IRQ_CAPTURE_PLAY_POINT) ||
+             (capture == ISD17XX_IRQ_CAPTURE_RECORD_POINT))                               /* status and point */
     {
-        handle->debug_print("isd17xx: set clear interrupt failed.\n");            /* set clear interrupt failed */
-
-        return 1;                                                                 /* return error */
+        if (capture == ISD17XX_IRQ_CAPTURE_PLAY_POINT)                                    /* play point */
+        {
+            buf[0] = ISD17XX_COMMAND_RD_PLAY_PTR;                                         /* read play point command */
+        }
+        else
+        {
+            buf[0] = ISD17XX_COMMAND_RD_REC_PTR;                                          /* read record point command */
+        }
+        buf[1] = 0x00;                                                                    /* set 0x00 */
+        buf[2] = 0x00;                                                                    /* set 0x00 */
+        buf[3] = 0x00;                                                                    /* set 0x00 */
+        if (handle->spi_transmit_vector != NULL)                                          /* one bus transaction */
+        {
+            clear[0] = ISD17XX_COMMAND_CLR_INT;                                           /* set clear interrupt command */
+            clear[1] = 0x00;                                                              /* set 0x00 */
+            seg[0].tx = buf;                                                              /* set the point tx */
+            seg[0].rx = data;                                                             /* set the point rx */
+            seg[0].len = 4;                                                               /* set 4 */
+            seg[1].tx = clear;                                                            /* set the clear tx */
+            seg[1].rx = clear_data;                                                       /* set the clear rx */
+            seg[1].len = 2;                                                               /* set 2 */
+            if (a_isd17xx_spi_transmit_vector(handle, seg, 2) != 0)                       /* read the point and clear interrupt */
+            {
+                handle->debug_print("isd17xx: read point failed.\n");                     /* read point failed */
+                
+                return 1;                                                                 /* return error */
+            }
+            *status1 = ((uint16_t)data[0]) << 8 | data[1];                                /* set the status1 */
+            *point = (uint16_t)(data[3] & 0x7) << 8 | data[2];                            /* set the point */
+        }
+        else
+        {
+            if (a_isd17xx_spi_transmit(handle, buf, data, 4) != 0)                        /* read status1 and the point */
+            {
+                handle->debug_print("isd17xx: read point failed.\n");                     /* read point failed */
+                
+                return 1;                                                                 /* return error */
+            }
+            *status1 = ((uint16_t)data[0]) << 8 | data[1];                                /* set the status1 */
+            *point = (uint16_t)(data[3] & 0x7) << 8 | data[2];                            /* set the point */
+            if ((*status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)            /* check the eom and int */
+            {
+                buf[0] = 0x00;                                                            /* set 0x00 */
+                if (a_isd17xx_spi_write(handle, ISD17XX_COMMAND_CLR_INT, buf, 1) != 0)    /* set clear interrupt */
+                {
+                    handle->debug_print("isd17xx: set clear interrupt failed.\n");        /* set clear interrupt failed */
+                    
+                    return 1;                                                             /* return error */
+                }
+            }
+        }
+    }
+    else
+    {
+        handle->debug_print("isd17xx: capture is invalid.\n");                            /* capture is invalid */
+        
+        return 4;                                                                         /* return error */
     }
-    if ((status1 & ISD17XX_STATUS1_EOM) != 0)                                     /* check the eom */
+    
+    if ((*status1 & ISD17XX_STATUS1_EOM) != 0)                                            /* check the eom */
     {
-        if (handle->receive_callback != NULL)                                     /* if receive_callback not null */
+        if (handle->receive_callback != NULL)                                             /* if receive_callback not null */
         {
-            handle->receive_callback(ISD17XX_STATUS1_EOM);                        /* run the callback */
+            handle->receive_callback(ISD17XX_STATUS1_EOM);                                /* run the callback */
         }
     }
-    if ((status1 & ISD17XX_STATUS1_INT) != 0)                                     /* check the int */
+    if ((*status1 & ISD17XX_STATUS1_INT) != 0)                                            /* check the int */
     {
-        handle->done = 1;                                                         /* flag done */
-        if (handle->receive_callback != NULL)                                     /* if receive_callback not null */
+        handle->done = 1;                                                                 /* flag done */
+        if (handle->receive_callback != NULL)                                             /* if receive_callback not null */
         {
-            handle->receive_callback(ISD17XX_STATUS1_INT);                        /* run the callback */
+            handle->receive_callback(ISD17XX_STATUS1_INT);                                /* run the callback */
         }
     }
-
-    return 0;                                                                     /* success return 0 */
+    
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
@@ -2738,7 +3259,7 @@ uint8_t isd17xx_get_type(isd17xx_handle_t *handle, isd17xx_type_t *type)
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the message index is dropped, the command may change the memory
  */
 uint8_t isd17xx_set_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uint16_t len)
 {
@@ -2750,6 +3271,8 @@ uint8_t isd17xx_set_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uin
     {
         return 3;                                             /* return error */
     }
+    
+    handle->message_index_valid = 0;                          /* invalidate the message index */
 
     return a_isd17xx_spi_write(handle, cmd, buf, len);        /* write data */
 }
@@ -2781,6 +3304,151 @@ uint8_t isd17xx_get_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uin
     return a_isd17xx_spi_read(handle, cmd, buf, len);        /* read data */
 }
 
+/**
+ * @brief      encode a frame
+ * @param[in]  command chip command
+ * @param[in]  *payload pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 frame is NULL
+ * @note       frame must hold len + 1 bytes, payload can be NULL when len is 0
+ */
+uint8_t isd17xx_frame_encode(uint8_t command, const uint8_t *payload, uint16_t len, uint8_t *frame)
+{
+    uint16_t i;
+    
+    if ((frame == NULL) || ((payload == NULL) && (len != 0)))        /* check the buffer */
+    {
+        return 2;                                                    /* return error */
+    }
+    
+    frame[0] = a_high_low_shift(command);                            /* set the command */
+    for (i = 0; i < len; i++)                                        /* loop all */
+    {
+        frame[i + 1] = a_high_low_shift(payload[i]);                 /* msb to lsb */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief         decode a response frame
+ * @param[in,out] *frame pointer to a frame buffer
+ * @param[in]     len frame length
+ * @return        status code
+ *                - 0 success
+ *                - 2 frame is NULL
+ * @note          the first two bytes are the status1
+ */
+uint8_t isd17xx_frame_decode(uint8_t *frame, uint16_t len)
+{
+    uint16_t i;
+    
+    if (frame == NULL)                                   /* check the buffer */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                            /* loop all */
+    {
+        frame[i] = a_high_low_shift(frame[i]);           /* lsb to msb */
+    }
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief         send encoded frames
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 num is invalid
+ * @note          num is 1 to ISD17XX_SPI_SEGMENT_MAX on every transport,
+ *                the frames share one transport call when spi_transmit_vector is linked,
+ *                the responses are left encoded, the cached status is dropped,
+ *                the caller drops the message index when a frame may change the memory
+ */
+uint8_t isd17xx_frame_transmit(isd17xx_handle_t *handle, isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    if ((handle == NULL) || (seg == NULL))                          /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    if ((num == 0) || (num > ISD17XX_SPI_SEGMENT_MAX))              /* check the num */
+    {
+        handle->debug_print("isd17xx: num is invalid.\n");          /* num is invalid */
+        
+        return 4;                                                   /* return error */
+    }
+    
+    handle->status_cache_valid = 0;                                 /* the frames may change the status */
+    if (a_isd17xx_frame_transmit(handle, seg, num) != 0)            /* send the frames */
+    {
+        handle->debug_print("isd17xx: frame transmit failed.\n");   /* frame transmit failed */
+        
+        return 1;                                                   /* return error */
+    }
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      send a command without waiting
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  command chip command
+ * @param[out] *status1 pointer to a status1 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 send failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one two byte frame without the command delay or a status poll,
+ *             status1 is the status before the command
+ */
+uint8_t isd17xx_send_command(isd17xx_handle_t *handle, uint8_t command, uint16_t *status1)
+{
+    uint8_t buf[2];
+    uint8_t data[2];
+    
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    if ((command == ISD17XX_COMMAND_REC) || (command == ISD17XX_COMMAND_ERASE) ||
+        (command == ISD17XX_COMMAND_G_ERASE))                                       /* check the memory commands */
+    {
+        handle->message_index_valid = 0;                                            /* invalidate the message index */
+    }
+    handle->status_cache_valid = 0;                                                 /* the command may change the status */
+    buf[0] = command;                                                               /* set the command */
+    buf[1] = 0x00;                                                                  /* set 0x00 */
+    if (a_isd17xx_spi_transmit(handle, buf, data, 2) != 0)                          /* send the command */
+    {
+        handle->debug_print("isd17xx: send command failed.\n");                     /* send command failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    *status1 = ((uint16_t)data[0]) << 8 | data[1];                                  /* set the status1 */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
 /**
  * @brief      get chip's information
  * @param[out] *info pointer to an isd17xx info structure
@@ -100,6 +100,24 @@ typedef enum
     ISD17XX_VOL_CONTROL_REG    = 0x01,        /**< register control */
 } isd17xx_vol_control_t;
 
+/**
+ * @brief isd17xx apc field enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_APC_FIELD_VOLUME                 = 0x00,        /**< volume, bit 0 - 2 */
+    ISD17XX_APC_FIELD_MONITOR_INPUT          = 0x01,        /**< monitor input, bit 3 */
+    ISD17XX_APC_FIELD_MIX_INPUT              = 0x02,        /**< mix input, bit 4 */
+    ISD17XX_APC_FIELD_SOUND_EFFECT_EDITING   = 0x03,        /**< sound effect editing, bit 5 active low */
+    ISD17XX_APC_FIELD_SPI_FT                 = 0x04,        /**< spi ft, bit 6 active low */
+    ISD17XX_APC_FIELD_ANALOG_OUTPUT          = 0x05,        /**< analog output, bit 7 */
+    ISD17XX_APC_FIELD_PWM_SPEAKER            = 0x06,        /**< pwm speaker, bit 8 active low */
+    ISD17XX_APC_FIELD_POWER_UP_ANALOG_OUTPUT = 0x07,        /**< power up analog output, bit 9 active low */
+    ISD17XX_APC_FIELD_V_ALERT                = 0x08,        /**< v alert, bit 10 active low */
+    ISD17XX_APC_FIELD_EOM                    = 0x09,        /**< eom, bit 11 */
+    ISD17XX_APC_FIELD_NUM                    = 0x0A,        /**< field number */
+} isd17xx_apc_field_t;
+
 /**
  * @brief isd17xx status1 enumeration definition
  */
@@ -127,27 +145,123 @@ typedef enum
     ISD17XX_STATUS2_SE1   = (1 << 7),        /**< se1 */
 } isd17xx_status2_t;
 
+/**
+ * @brief isd17xx irq capture enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_IRQ_CAPTURE_NONE         = 0x00,        /**< status only */
+    ISD17XX_IRQ_CAPTURE_PLAY_POINT   = 0x01,        /**< status and play point */
+    ISD17XX_IRQ_CAPTURE_RECORD_POINT = 0x02,        /**< status and record point */
+} isd17xx_irq_capture_t;
+
+/**
+ * @brief isd17xx command enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_COMMAND_PU          = 0x01,        /**< power up command */
+    ISD17XX_COMMAND_STOP        = 0x02,        /**< stop command */
+    ISD17XX_COMMAND_RESET       = 0x03,        /**< reset command */
+    ISD17XX_COMMAND_CLR_INT     = 0x04,        /**< clear interrupt command */
+    ISD17XX_COMMAND_RD_STATUS   = 0x05,        /**< read status command */
+    ISD17XX_COMMAND_RD_PLAY_PTR = 0x06,        /**< read play point command */
+    ISD17XX_COMMAND_PD          = 0x07,        /**< power down command */
+    ISD17XX_COMMAND_RD_REC_PTR  = 0x08,        /**< read record point command */
+    ISD17XX_COMMAND_DEVID       = 0x09,        /**< device id command */
+    ISD17XX_COMMAND_PLAY        = 0x40,        /**< play command */
+    ISD17XX_COMMAND_REC         = 0x41,        /**< record command */
+    ISD17XX_COMMAND_ERASE       = 0x42,        /**< erase command */
+    ISD17XX_COMMAND_G_ERASE     = 0x43,        /**< erase all command */
+    ISD17XX_COMMAND_RD_APC      = 0x44,        /**< read apc command */
+    ISD17XX_COMMAND_WR_APC1     = 0x45,        /**< write apc1 command */
+    ISD17XX_COMMAND_WR_APC2     = 0x65,        /**< write apc2 command */
+    ISD17XX_COMMAND_WR_NVCFG    = 0x46,        /**< write nvcfg command */
+    ISD17XX_COMMAND_LD_NVCFG    = 0x47,        /**< load nvcfg command */
+    ISD17XX_COMMAND_FWD         = 0x48,        /**< forward command */
+    ISD17XX_COMMAND_CHK_MEM     = 0x49,        /**< check memory command */
+    ISD17XX_COMMAND_EXTCLK      = 0x4A,        /**< extern clock command */
+    ISD17XX_COMMAND_SET_PLAY    = 0x80,        /**< set play command */
+    ISD17XX_COMMAND_SET_REC     = 0x81,        /**< set record command */
+    ISD17XX_COMMAND_SET_ERASE   = 0x82,        /**< set erase command */
+} isd17xx_command_t;
+
+/**
+ * @brief isd17xx message index max definition
+ */
+#ifndef ISD17XX_MESSAGE_INDEX_MAX
+    #define ISD17XX_MESSAGE_INDEX_MAX        32        /**< max cached messages */
+#endif
+
+/**
+ * @brief isd17xx spi segment max definition
+ */
+#ifndef ISD17XX_SPI_SEGMENT_MAX
+    #define ISD17XX_SPI_SEGMENT_MAX        4        /**< max segments in one vectored transfer */
+#endif
+
+/**
+ * @brief isd17xx spi segment structure definition
+ */
+typedef struct isd17xx_spi_segment_s
+{
+    uint8_t *tx;         /**< tx buffer */
+    uint8_t *rx;         /**< rx buffer */
+    uint16_t len;        /**< length of both buffers */
+} isd17xx_spi_segment_t;
+
+/**
+ * @brief isd17xx snapshot structure definition
+ */
+typedef struct isd17xx_snapshot_s
+{
+    uint16_t status1;             /**< status1 */
+    uint8_t status2;              /**< status2 */
+    uint16_t play_point;          /**< play point */
+    uint16_t record_point;        /**< record point */
+} isd17xx_snapshot_t;
+
 /**
  * @brief isd17xx handle structure definition
  */
 typedef struct isd17xx_handle_s
 {
-    uint8_t (*spi_init)(void);                                              /**< point to a spi_init function address */
-    uint8_t (*spi_deinit)(void);                                            /**< point to a spi_deinit function address */
-    uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);           /**< point to a spi_read function address */
-    uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);          /**< point to a spi_write function address */
-    uint8_t (*spi_transmit)(uint8_t *tx, uint8_t *rx, uint16_t len);        /**< point to a spi_transmit function address */
-    uint8_t (*gpio_reset_init)(void);                                       /**< point to a gpio_reset_init function address */
-    uint8_t (*gpio_reset_deinit)(void);                                     /**< point to a gpio_reset_deinit function address */
-    uint8_t (*gpio_reset_write)(uint8_t level);                             /**< point to a gpio_reset_write function address */
-    void (*receive_callback)(uint16_t type);                                /**< point to a receive_callback function address */
-    void (*delay_ms)(uint32_t ms);                                          /**< point to a delay_ms function address */
-    void (*debug_print)(const char *const fmt, ...);                        /**< point to a debug_print function address */
-    uint16_t end_address;                                                   /**< end address */
-    uint8_t vol_control;                                                    /**< vol control */
-    uint8_t type;                                                           /**< chip type */
-    uint8_t inited;                                                         /**< inited flag */
-    uint8_t done;                                                           /**< done flag */
+    uint8_t (*spi_init)(void);                                                  /**< point to a spi_init function address */
+    uint8_t (*spi_deinit)(void);                                                /**< point to a spi_deinit function address */
+    uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);               /**< point to a spi_read function address */
+    uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);              /**< point to a spi_write function address */
+    uint8_t (*spi_transmit)(uint8_t *tx, uint8_t *rx, uint16_t len);            /**< point to a spi_transmit function address */
+    uint8_t (*spi_transmit_vector)(isd17xx_spi_segment_t *seg, uint8_t num);    /**< point to a spi_transmit_vector function address */
+    uint8_t (*gpio_reset_init)(void);                                           /**< point to a gpio_reset_init function address */
+    uint8_t (*gpio_reset_deinit)(void);                                         /**< point to a gpio_reset_deinit function address */
+    uint8_t (*gpio_reset_write)(uint8_t level);                                 /**< point to a gpio_reset_write function address */
+    void (*receive_callback)(uint16_t type);                                    /**< point to a receive_callback function address */
+    void (*delay_ms)(uint32_t ms);                                              /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                              /**< point to a delay_us function address */
+    uint64_t (*get_time_us)(void);                                              /**< point to a get_time_us function address */
+    void (*debug_print)(const char *const fmt, ...);                            /**< point to a debug_print function address */
+    uint16_t end_address;                                                       /**< end address */
+    uint16_t command_delay;                                                     /**< command delay in ms */
+    uint16_t status1_cache;                                                     /**< cached status1 */
+    uint8_t status2_cache;                                                      /**< cached status2 */
+    uint8_t status_cache_valid;                                                 /**< cached status valid flag */
+    uint32_t status_max_age;                                                    /**< status cache max age in us */
+    uint64_t status_cache_time;                                                 /**< cached status timestamp in us */
+    uint32_t status_cache_hit;                                                  /**< status cache hit count */
+    uint32_t status_cache_miss;                                                 /**< status cache miss count */
+    uint64_t clock_us;                                                          /**< delay_ms driven clock in us */
+    uint32_t delay_count;                                                       /**< timed delay count */
+    uint32_t delay_overshoot_max;                                               /**< max delay overshoot in us */
+    uint64_t delay_overshoot_sum;                                               /**< delay overshoot sum in us */
+    uint32_t frame_count;                                                       /**< spi frame count */
+    uint16_t message_start[ISD17XX_MESSAGE_INDEX_MAX];                          /**< message start address */
+    uint16_t message_end[ISD17XX_MESSAGE_INDEX_MAX];                            /**< message end address */
+    uint8_t message_num;                                                        /**< message number */
+    uint8_t message_index_valid;                                                /**< message index valid flag */
+    uint8_t vol_control;                                                        /**< vol control */
+    uint8_t type;                                                               /**< chip type */
+    uint8_t inited;                                                             /**< inited flag */
+    uint8_t done;                                                               /**< done flag */
 } isd17xx_handle_t;
 
 /**
@@ -225,6 +339,14 @@ typedef struct isd17xx_info_s
  */
 #define DRIVER_ISD17XX_LINK_SPI_TRANSMIT(HANDLE, FUC)             (HANDLE)->spi_transmit = FUC
 
+/**
+ * @brief     link spi_transmit_vector function
+ * @param[in] HANDLE pointer to an isd17xx handle structure
+ * @param[in] FUC pointer to a spi_transmit_vector function address
+ * @note      optional, every segment is a separate chip select cycle inside one bus transaction
+ */
+#define DRIVER_ISD17XX_LINK_SPI_TRANSMIT_VECTOR(HANDLE, FUC)      (HANDLE)->spi_transmit_vector = FUC
+
 /**
  * @brief     link gpio_reset_init function
  * @param[in] HANDLE pointer to an isd17xx handle structure
@@ -257,6 +379,22 @@ typedef struct isd17xx_info_s
  */
 #define DRIVER_ISD17XX_LINK_DELAY_MS(HANDLE, FUC)                 (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to an isd17xx handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      optional, with get_time_us linked too the driver waits on absolute deadlines in us
+ */
+#define DRIVER_ISD17XX_LINK_DELAY_US(HANDLE, FUC)                 (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link get_time_us function
+ * @param[in] HANDLE pointer to an isd17xx handle structure
+ * @param[in] FUC pointer to a get_time_us function address
+ * @note      optional, only the timed modules use it
+ */
+#define DRIVER_ISD17XX_LINK_GET_TIME_US(HANDLE, FUC)              (HANDLE)->get_time_us = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to an isd17xx handle structure
@@ -328,6 +466,28 @@ uint8_t isd17xx_get_type(isd17xx_handle_t *handle, isd17xx_type_t *type);
  */
 uint8_t isd17xx_irq_handler(isd17xx_handle_t *handle);
 
+/**
+ * @brief      irq service with the fewest spi frames
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  capture pointer capture mode
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *point pointer to a point buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 capture is invalid
+ * @note       status1 is the value before the interrupt is cleared
+ *             every spi frame returns the status1 in its first two bytes,
+ *             so the clear interrupt or point read frame doubles as the status read
+ *             without capture one clear interrupt frame is sent and point is not written
+ *             with capture the point read frame is followed by a clear interrupt frame only if eom or int is set
+ *             with spi_transmit_vector linked the point read and clear interrupt share one bus transaction
+ *             the frames carry no status2, so the status cache is dropped rather than refreshed
+ */
+uint8_t isd17xx_irq_service(isd17xx_handle_t *handle, isd17xx_irq_capture_t capture, uint16_t *status1, uint16_t *point);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an isd17xx handle structure
@@ -516,6 +676,20 @@ uint8_t isd17xx_clear_interrupt(isd17xx_handle_t *handle);
  */
 uint8_t isd17xx_get_status(isd17xx_handle_t *handle, uint16_t *status1, uint8_t *status2);
 
+/**
+ * @brief      read the status and both points
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the three frames share one bus transaction when spi_transmit_vector is linked,
+ *             the interrupt is cleared like get status
+ */
+uint8_t isd17xx_read_snapshot(isd17xx_handle_t *handle, isd17xx_snapshot_t *snapshot);
+
 /**
  * @brief      get the device id
  * @param[in]  *handle pointer to an isd17xx handle structure
@@ -580,6 +754,91 @@ uint8_t isd17xx_set_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control
  */
 uint8_t isd17xx_get_volume_control(isd17xx_handle_t *handle, isd17xx_vol_control_t *control);
 
+/**
+ * @brief     set an apc field
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] field apc field
+ * @param[in] value field value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set apc field failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 field is invalid
+ *            - 5 value is invalid
+ * @note      value is the logical value, active low bits are inverted inside
+ */
+uint8_t isd17xx_apc_set_field(isd17xx_handle_t *handle, isd17xx_apc_field_t field, uint8_t value);
+
+/**
+ * @brief      get an apc field
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  field apc field
+ * @param[out] *value pointer to a field value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get apc field failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 field is invalid
+ * @note       value is the logical value, active low bits are inverted inside
+ */
+uint8_t isd17xx_apc_get_field(isd17xx_handle_t *handle, isd17xx_apc_field_t field, uint8_t *value);
+
+/**
+ * @brief      read the whole apc register
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *config pointer to an apc register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read apc failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one read apc frame, decode it with isd17xx_apc_decode_field
+ */
+uint8_t isd17xx_apc_read(isd17xx_handle_t *handle, uint16_t *config);
+
+/**
+ * @brief     write the whole apc register
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] config apc register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write apc failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      one write apc frame, all fields change at once,
+ *            build the value with isd17xx_apc_encode_field
+ */
+uint8_t isd17xx_apc_write(isd17xx_handle_t *handle, uint16_t config);
+
+/**
+ * @brief         encode an apc field
+ * @param[in,out] *config pointer to an apc register value
+ * @param[in]     field apc field
+ * @param[in]     value field value
+ * @return        status code
+ *                - 0 success
+ *                - 2 config is NULL
+ *                - 4 field is invalid
+ *                - 5 value is invalid
+ * @note          value is the logical value, active low bits are inverted inside, no bus access
+ */
+uint8_t isd17xx_apc_encode_field(uint16_t *config, isd17xx_apc_field_t field, uint8_t value);
+
+/**
+ * @brief      decode an apc field
+ * @param[in]  config apc register value
+ * @param[in]  field apc field
+ * @param[out] *value pointer to a field value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 value is NULL
+ *             - 4 field is invalid
+ * @note       value is the logical value, active low bits are inverted inside, no bus access
+ */
+uint8_t isd17xx_apc_decode_field(uint16_t config, isd17xx_apc_field_t field, uint8_t *value);
+
 /**
  * @brief     set the volume
  * @param[in] *handle pointer to an isd17xx handle structure
@@ -617,6 +876,7 @@ uint8_t isd17xx_get_volume(isd17xx_handle_t *handle, uint8_t *vol);
  *            - 1 set monitor input failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -643,6 +903,7 @@ uint8_t isd17xx_get_monitor_input(isd17xx_handle_t *handle, isd17xx_bool_t *enab
  *            - 1 set mix input failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -669,6 +930,7 @@ uint8_t isd17xx_get_mix_input(isd17xx_handle_t *handle, isd17xx_bool_t *enable);
  *            - 1 set sound effect editing failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -695,6 +957,7 @@ uint8_t isd17xx_get_sound_effect_editing(isd17xx_handle_t *handle, isd17xx_bool_
  *            - 1 set spi ft failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -721,6 +984,7 @@ uint8_t isd17xx_get_spi_ft(isd17xx_handle_t *handle, isd17xx_bool_t *enable);
  *            - 1 set analog output failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 output is invalid
  * @note      none
  */
 uint8_t isd17xx_set_analog_output(isd17xx_handle_t *handle, isd17xx_analog_output_t output);
@@ -747,6 +1011,7 @@ uint8_t isd17xx_get_analog_output(isd17xx_handle_t *handle, isd17xx_analog_outpu
  *            - 1 set pwm speaker failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -773,6 +1038,7 @@ uint8_t isd17xx_get_pwm_speaker(isd17xx_handle_t *handle, isd17xx_bool_t *enable
  *            - 1 set power up analog output failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_power_up_analog_output(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -799,6 +1065,7 @@ uint8_t isd17xx_get_power_up_analog_output(isd17xx_handle_t *handle, isd17xx_boo
  *            - 1 set v alert failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -825,6 +1092,7 @@ uint8_t isd17xx_get_v_alert(isd17xx_handle_t *handle, isd17xx_bool_t *enable);
  *            - 1 set eom failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 enable is invalid
  * @note      none
  */
 uint8_t isd17xx_set_eom(isd17xx_handle_t *handle, isd17xx_bool_t enable);
@@ -926,6 +1194,166 @@ uint8_t isd17xx_set_erase(isd17xx_handle_t *handle, uint16_t start_addr, uint16_
  */
 uint8_t isd17xx_toggle_extern_clock(isd17xx_handle_t *handle);
 
+/**
+ * @brief     set the command delay
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] ms delay in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the delay is applied after play, record, erase, global erase, next,
+ *            set play, set record and set erase, default is 500ms
+ *            0 means no delay and the caller must poll the status
+ */
+uint8_t isd17xx_set_command_delay(isd17xx_handle_t *handle, uint16_t ms);
+
+/**
+ * @brief      get the command delay
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *ms pointer to a delay buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_command_delay(isd17xx_handle_t *handle, uint16_t *ms);
+
+/**
+ * @brief     set the status cache max age
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] us max age in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_us is NULL
+ * @note      get status is served from the cache while the last read is younger than us,
+ *            0 disables the cache and is the default
+ *            irq events and state changing commands drop the cache, so the next get status reads the chip
+ */
+uint8_t isd17xx_set_status_max_age(isd17xx_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get the status cache max age
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *us pointer to a max age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_get_status_max_age(isd17xx_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      get the status cache statistics
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *hit pointer to a hit count buffer
+ * @param[out] *miss pointer to a miss count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       hit rate is hit / (hit + miss), the counters are cleared when the max age is set
+ */
+uint8_t isd17xx_get_status_cache_statistics(isd17xx_handle_t *handle, uint32_t *hit, uint32_t *miss);
+
+/**
+ * @brief      get the driver clock
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       get_time_us when delay_us and get_time_us are linked,
+ *             otherwise a clock only advanced by the driver delays
+ */
+uint8_t isd17xx_get_clock(isd17xx_handle_t *handle, uint64_t *us);
+
+/**
+ * @brief     wait until a deadline
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] deadline_us deadline on the driver clock in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      returns at once if the deadline has passed, so polling loops
+ *            do not drift by the bus time and the sleep overshoot
+ */
+uint8_t isd17xx_delay_until(isd17xx_handle_t *handle, uint64_t deadline_us);
+
+/**
+ * @brief      get the delay statistics
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *count pointer to a delay count buffer
+ * @param[out] *mean_us pointer to a mean overshoot buffer
+ * @param[out] *max_us pointer to a max overshoot buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only the delay_us waits are measured, the counters are cleared by init
+ */
+uint8_t isd17xx_get_delay_statistics(isd17xx_handle_t *handle, uint32_t *count, uint32_t *mean_us, uint32_t *max_us);
+
+/**
+ * @brief     clear the delay statistics
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_clear_delay_statistics(isd17xx_handle_t *handle);
+
+/**
+ * @brief     build the message index
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 build message index failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the chip must be in standby, the play point is moved
+ *            the index is dropped by init, hardware reset, set_reg,
+ *            record, erase and global erase
+ */
+uint8_t isd17xx_build_message_index(isd17xx_handle_t *handle);
+
+/**
+ * @brief      get the message number
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *num pointer to a message number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get message number failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the message index is built if it is not cached
+ */
+uint8_t isd17xx_get_message_number(isd17xx_handle_t *handle, uint8_t *num);
+
+/**
+ * @brief     play the message
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] n message index
+ * @return    status code
+ *            - 0 success
+ *            - 1 play message failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 n is invalid
+ * @note      the message index is built if it is not cached
+ *            the message is played with one set play command,
+ *            a one row message is played to the next row
+ */
+uint8_t isd17xx_play_message(isd17xx_handle_t *handle, uint8_t n);
+
 /**
  * @}
  */
@@ -948,7 +1376,7 @@ uint8_t isd17xx_toggle_extern_clock(isd17xx_handle_t *handle);
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the message index is dropped, the command may change the memory
  */
 uint8_t isd17xx_set_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uint16_t len);
 
@@ -967,6 +1395,63 @@ uint8_t isd17xx_set_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uin
  */
 uint8_t isd17xx_get_reg(isd17xx_handle_t *handle, uint8_t cmd, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      encode a frame
+ * @param[in]  command chip command
+ * @param[in]  *payload pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 frame is NULL
+ * @note       frame must hold len + 1 bytes, payload can be NULL when len is 0
+ */
+uint8_t isd17xx_frame_encode(uint8_t command, const uint8_t *payload, uint16_t len, uint8_t *frame);
+
+/**
+ * @brief         decode a response frame
+ * @param[in,out] *frame pointer to a frame buffer
+ * @param[in]     len frame length
+ * @return        status code
+ *                - 0 success
+ *                - 2 frame is NULL
+ * @note          the first two bytes are the status1
+ */
+uint8_t isd17xx_frame_decode(uint8_t *frame, uint16_t len);
+
+/**
+ * @brief         send encoded frames
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transmit failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 num is invalid
+ * @note          num is 1 to ISD17XX_SPI_SEGMENT_MAX on every transport,
+ *                the frames share one transport call when spi_transmit_vector is linked,
+ *                the responses are left encoded, the cached status is dropped,
+ *                the caller drops the message index when a frame may change the memory
+ */
+uint8_t isd17xx_frame_transmit(isd17xx_handle_t *handle, isd17xx_spi_segment_t *seg, uint8_t num);
+
+/**
+ * @brief      send a command without waiting
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  command chip command
+ * @param[out] *status1 pointer to a status1 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 send failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one two byte frame without the command delay or a status poll,
+ *             status1 is the status before the command
+ */
+uint8_t isd17xx_send_command(isd17xx_handle_t *handle, uint8_t command, uint16_t *status1);
+
 /**
  * @}
  */
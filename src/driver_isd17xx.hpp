@@ -0,0 +1,542 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx.hpp
+ * @brief     driver isd17xx c++ wrapper header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_HPP
+#define DRIVER_ISD17XX_HPP
+
+#include "driver_isd17xx_interface.h"
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @defgroup isd17xx_cpp_driver isd17xx c++ driver function
+ * @brief    isd17xx c++ driver modules
+ * @ingroup  isd17xx_driver
+ * @note     header only, needs c++17
+ * @{
+ */
+
+namespace isd17xx
+{
+
+/**
+ * @brief error structure definition
+ * @note  code is the status code of the failed c function, function is its name
+ */
+struct Error
+{
+    uint8_t code;            /**< status code */
+    const char *function;    /**< failed function */
+};
+
+/**
+ * @brief expected style result class definition
+ * @note  holds either a value or an error, nothing is thrown
+ */
+template <class T>
+class [[nodiscard]] Result
+{
+    public:
+        /**
+         * @brief     make a result holding a value
+         * @param[in] value result value
+         * @note      none
+         */
+        Result(T value) : m_value(std::move(value)), m_error{0, nullptr} {}
+        
+        /**
+         * @brief     make a result holding an error
+         * @param[in] error result error
+         * @note      none
+         */
+        Result(Error error) : m_value(), m_error(error) {}
+        
+        /**
+         * @brief  check the value
+         * @return true if a value is held
+         * @note   none
+         */
+        bool has_value() const noexcept { return m_value.has_value(); }
+        
+        /**
+         * @brief  check the value
+         * @return true if a value is held
+         * @note   none
+         */
+        explicit operator bool() const noexcept { return m_value.has_value(); }
+        
+        /**
+         * @brief  get the value
+         * @return reference to the value
+         * @note   only valid when has_value is true
+         */
+        T &value() & noexcept { return *m_value; }
+        
+        /**
+         * @brief  get the value
+         * @return reference to the value
+         * @note   only valid when has_value is true
+         */
+        const T &value() const & noexcept { return *m_value; }
+        
+        /**
+         * @brief  move the value out
+         * @return the value
+         * @note   only valid when has_value is true
+         */
+        T &&value() && noexcept { return std::move(*m_value); }
+        
+        /**
+         * @brief  get the error
+         * @return the error
+         * @note   only valid when has_value is false
+         */
+        Error error() const noexcept { return m_error; }
+    
+    private:
+        std::optional<T> m_value;    /**< value */
+        Error m_error;               /**< error */
+};
+
+/**
+ * @brief expected style result class definition for operations without a value
+ */
+template <>
+class [[nodiscard]] Result<void>
+{
+    public:
+        /**
+         * @brief make a success result
+         * @note  none
+         */
+        Result() noexcept : m_error{0, nullptr} {}
+        
+        /**
+         * @brief     make a result holding an error
+         * @param[in] error result error
+         * @note      none
+         */
+        Result(Error error) noexcept : m_error(error) {}
+        
+        /**
+         * @brief  check the success
+         * @return true on success
+         * @note   none
+         */
+        bool has_value() const noexcept { return m_error.code == 0; }
+        
+        /**
+         * @brief  check the success
+         * @return true on success
+         * @note   none
+         */
+        explicit operator bool() const noexcept { return m_error.code == 0; }
+        
+        /**
+         * @brief  get the error
+         * @return the error
+         * @note   only valid when has_value is false
+         */
+        Error error() const noexcept { return m_error; }
+    
+    private:
+        Error m_error;    /**< error */
+};
+
+/**
+ * @brief     convert a status code
+ * @param[in] code status code
+ * @param[in] *function pointer to the function name
+ * @return    result
+ * @note      none
+ */
+inline Result<void> check(uint8_t code, const char *function) noexcept
+{
+    if (code != 0)
+    {
+        return Error{code, function};
+    }
+    
+    return {};
+}
+
+/**
+ * @brief strongly typed apc configuration structure definition
+ */
+struct ApcConfig
+{
+    uint8_t volume = 0;                                                 /**< volume, 0 is max and 7 is min */
+    bool monitor_input = false;                                         /**< monitor input */
+    bool mix_input = false;                                             /**< mix input */
+    bool sound_effect_editing = false;                                  /**< sound effect editing */
+    bool spi_ft = false;                                                /**< spi ft */
+    isd17xx_analog_output_t analog_output = ISD17XX_ANALOG_OUTPUT_AUD;  /**< analog output */
+    bool pwm_speaker = false;                                           /**< pwm speaker */
+    bool power_up_analog_output = false;                                /**< power up analog output */
+    bool v_alert = false;                                               /**< v alert */
+    bool eom = false;                                                   /**< eom */
+};
+
+/**
+ * @brief transport policy using the isd17xx_interface functions
+ * @note  a transport policy is a type with static functions matching the handle links,
+ *        delay_us, get_time_us, spi_transmit_vector and receive_callback are optional
+ */
+struct InterfaceTransport
+{
+    static uint8_t spi_init() { return isd17xx_interface_spi_init(); }
+    static uint8_t spi_deinit() { return isd17xx_interface_spi_deinit(); }
+    static uint8_t spi_read(uint8_t reg, uint8_t *buf, uint16_t len) { return isd17xx_interface_spi_read(reg, buf, len); }
+    static uint8_t spi_write(uint8_t reg, uint8_t *buf, uint16_t len) { return isd17xx_interface_spi_write(reg, buf, len); }
+    static uint8_t spi_transmit(uint8_t *tx, uint8_t *rx, uint16_t len) { return isd17xx_interface_spi_transmit(tx, rx, len); }
+    static uint8_t spi_transmit_vector(isd17xx_spi_segment_t *seg, uint8_t num) { return isd17xx_interface_spi_transmit_vector(seg, num); }
+    static uint8_t gpio_reset_init() { return isd17xx_interface_gpio_reset_init(); }
+    static uint8_t gpio_reset_deinit() { return isd17xx_interface_gpio_reset_deinit(); }
+    static uint8_t gpio_reset_write(uint8_t level) { return isd17xx_interface_gpio_reset_write(level); }
+    static void delay_ms(uint32_t ms) { isd17xx_interface_delay_ms(ms); }
+    static void delay_us(uint32_t us) { isd17xx_interface_delay_us(us); }
+    static uint64_t get_time_us() { return isd17xx_interface_get_time_us(); }
+    static void receive_callback(uint16_t type) { isd17xx_interface_receive_callback(type); }
+    static constexpr void (*debug_print)(const char *const fmt, ...) = isd17xx_interface_debug_print;
+};
+
+/**
+ * @brief optional transport member detection definition
+ */
+namespace detail
+{
+    template <class T, class = void> struct has_delay_us : std::false_type {};
+    template <class T> struct has_delay_us<T, std::void_t<decltype(&T::delay_us)>> : std::true_type {};
+    template <class T, class = void> struct has_get_time_us : std::false_type {};
+    template <class T> struct has_get_time_us<T, std::void_t<decltype(&T::get_time_us)>> : std::true_type {};
+    template <class T, class = void> struct has_spi_transmit_vector : std::false_type {};
+    template <class T> struct has_spi_transmit_vector<T, std::void_t<decltype(&T::spi_transmit_vector)>> : std::true_type {};
+    template <class T, class = void> struct has_receive_callback : std::false_type {};
+    template <class T> struct has_receive_callback<T, std::void_t<decltype(&T::receive_callback)>> : std::true_type {};
+}
+
+/**
+ * @brief move only device class definition
+ * @note  the destructor powers down and deinits the chip,
+ *        the handle lives on the heap so its address stays valid for other modules across moves
+ */
+template <class Transport = InterfaceTransport>
+class Device
+{
+    public:
+        /**
+         * @brief     link, set the type, init and power up a device
+         * @param[in] type chip type
+         * @return    device or error
+         * @note      init ends with a reset which powers the chip down,
+         *            so the device is powered up before it is returned
+         */
+        static Result<Device> open(isd17xx_type_t type)
+        {
+            std::unique_ptr<isd17xx_handle_t> handle(new isd17xx_handle_t);
+            
+            DRIVER_ISD17XX_LINK_INIT(handle.get(), isd17xx_handle_t);
+            DRIVER_ISD17XX_LINK_SPI_INIT(handle.get(), Transport::spi_init);
+            DRIVER_ISD17XX_LINK_SPI_DEINIT(handle.get(), Transport::spi_deinit);
+            DRIVER_ISD17XX_LINK_SPI_READ(handle.get(), Transport::spi_read);
+            DRIVER_ISD17XX_LINK_SPI_WRITE(handle.get(), Transport::spi_write);
+            DRIVER_ISD17XX_LINK_SPI_TRANSMIT(handle.get(), Transport::spi_transmit);
+            DRIVER_ISD17XX_LINK_GPIO_RESET_INIT(handle.get(), Transport::gpio_reset_init);
+            DRIVER_ISD17XX_LINK_GPIO_RESET_DEINIT(handle.get(), Transport::gpio_reset_deinit);
+            DRIVER_ISD17XX_LINK_GPIO_RESET_WRITE(handle.get(), Transport::gpio_reset_write);
+            DRIVER_ISD17XX_LINK_DELAY_MS(handle.get(), Transport::delay_ms);
+            DRIVER_ISD17XX_LINK_DEBUG_PRINT(handle.get(), Transport::debug_print);
+            if constexpr (detail::has_delay_us<Transport>::value)
+            {
+                DRIVER_ISD17XX_LINK_DELAY_US(handle.get(), Transport::delay_us);
+            }
+            if constexpr (detail::has_get_time_us<Transport>::value)
+            {
+                DRIVER_ISD17XX_LINK_GET_TIME_US(handle.get(), Transport::get_time_us);
+            }
+            if constexpr (detail::has_spi_transmit_vector<Transport>::value)
+            {
+                DRIVER_ISD17XX_LINK_SPI_TRANSMIT_VECTOR(handle.get(), Transport::spi_transmit_vector);
+            }
+            if constexpr (detail::has_receive_callback<Transport>::value)
+            {
+                DRIVER_ISD17XX_LINK_RECEIVE_CALLBACK(handle.get(), Transport::receive_callback);
+            }
+            
+            if (auto res = check(isd17xx_set_type(handle.get(), type), "isd17xx_set_type"); !res)
+            {
+                return res.error();
+            }
+            if (auto res = check(isd17xx_init(handle.get()), "isd17xx_init"); !res)
+            {
+                return res.error();
+            }
+            if (auto res = check(isd17xx_power_up(handle.get()), "isd17xx_power_up"); !res)
+            {
+                (void)isd17xx_deinit(handle.get());
+                
+                return res.error();
+            }
+            
+            return Device(std::move(handle));
+        }
+        
+        Device(const Device &) = delete;
+        Device &operator=(const Device &) = delete;
+        
+        /**
+         * @brief     move a device
+         * @param[in] other moved from device
+         * @note      none
+         */
+        Device(Device &&other) noexcept = default;
+        
+        /**
+         * @brief     move assign a device
+         * @param[in] other moved from device
+         * @return    this device
+         * @note      the current chip is closed first
+         */
+        Device &operator=(Device &&other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                m_handle = std::move(other.m_handle);
+            }
+            
+            return *this;
+        }
+        
+        /**
+         * @brief close the device
+         * @note  none
+         */
+        ~Device() { close(); }
+        
+        /**
+         * @brief  get the c handle
+         * @return pointer to the handle
+         * @note   for the other isd17xx modules
+         */
+        isd17xx_handle_t *get() const noexcept { return m_handle.get(); }
+        
+        /**
+         * @brief     set the play region and start playing
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    result
+         * @note      none
+         */
+        Result<void> play(uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return check(isd17xx_set_play(get(), start_addr, end_addr), "isd17xx_set_play");
+        }
+        
+        /**
+         * @brief     set the record region and start recording
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    result
+         * @note      none
+         */
+        Result<void> record(uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return check(isd17xx_set_record(get(), start_addr, end_addr), "isd17xx_set_record");
+        }
+        
+        /**
+         * @brief     erase a region
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    result
+         * @note      none
+         */
+        Result<void> erase(uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return check(isd17xx_set_erase(get(), start_addr, end_addr), "isd17xx_set_erase");
+        }
+        
+        /**
+         * @brief  stop the current operation
+         * @return result
+         * @note   none
+         */
+        Result<void> stop() noexcept
+        {
+            return check(isd17xx_stop(get()), "isd17xx_stop");
+        }
+        
+        /**
+         * @brief     set the command delay
+         * @param[in] ms delay in ms
+         * @return    result
+         * @note      none
+         */
+        Result<void> set_command_delay(uint16_t ms) noexcept
+        {
+            return check(isd17xx_set_command_delay(get(), ms), "isd17xx_set_command_delay");
+        }
+        
+        /**
+         * @brief  read the status and both points
+         * @return snapshot or error
+         * @note   none
+         */
+        Result<isd17xx_snapshot_t> snapshot() noexcept
+        {
+            isd17xx_snapshot_t snapshot;
+            
+            if (auto res = check(isd17xx_read_snapshot(get(), &snapshot), "isd17xx_read_snapshot"); !res)
+            {
+                return res.error();
+            }
+            
+            return snapshot;
+        }
+        
+        /**
+         * @brief  run the irq handler
+         * @return result
+         * @note   none
+         */
+        Result<void> irq_handler() noexcept
+        {
+            return check(isd17xx_irq_handler(get()), "isd17xx_irq_handler");
+        }
+        
+        /**
+         * @brief  read the apc configuration
+         * @return configuration or error
+         * @note   one apc register read
+         */
+        Result<ApcConfig> apc() noexcept
+        {
+            ApcConfig config;
+            uint16_t reg;
+            uint8_t value[ISD17XX_APC_FIELD_NUM];
+            
+            if (auto res = check(isd17xx_apc_read(get(), &reg), "isd17xx_apc_read"); !res)
+            {
+                return res.error();
+            }
+            for (uint8_t i = 0; i < ISD17XX_APC_FIELD_NUM; i++)
+            {
+                (void)isd17xx_apc_decode_field(reg, static_cast<isd17xx_apc_field_t>(i), &value[i]);
+            }
+            config.volume = value[ISD17XX_APC_FIELD_VOLUME];
+            config.monitor_input = value[ISD17XX_APC_FIELD_MONITOR_INPUT] != 0;
+            config.mix_input = value[ISD17XX_APC_FIELD_MIX_INPUT] != 0;
+            config.sound_effect_editing = value[ISD17XX_APC_FIELD_SOUND_EFFECT_EDITING] != 0;
+            config.spi_ft = value[ISD17XX_APC_FIELD_SPI_FT] != 0;
+            config.analog_output = static_cast<isd17xx_analog_output_t>(value[ISD17XX_APC_FIELD_ANALOG_OUTPUT]);
+            config.pwm_speaker = value[ISD17XX_APC_FIELD_PWM_SPEAKER] != 0;
+            config.power_up_analog_output = value[ISD17XX_APC_FIELD_POWER_UP_ANALOG_OUTPUT] != 0;
+            config.v_alert = value[ISD17XX_APC_FIELD_V_ALERT] != 0;
+            config.eom = value[ISD17XX_APC_FIELD_EOM] != 0;
+            
+            return config;
+        }
+        
+        /**
+         * @brief     write the apc configuration
+         * @param[in] &config apc configuration
+         * @return    result
+         * @note      the register is encoded first and written once,
+         *            an invalid field leaves the chip untouched
+         */
+        Result<void> apply(const ApcConfig &config) noexcept
+        {
+            const uint8_t value[ISD17XX_APC_FIELD_NUM] =
+            {
+                config.volume,
+                config.monitor_input,
+                config.mix_input,
+                config.sound_effect_editing,
+                config.spi_ft,
+                static_cast<uint8_t>(config.analog_output),
+                config.pwm_speaker,
+                config.power_up_analog_output,
+                config.v_alert,
+                config.eom,
+            };
+            uint16_t reg = 0;
+            
+            for (uint8_t i = 0; i < ISD17XX_APC_FIELD_NUM; i++)
+            {
+                if (auto res = check(isd17xx_apc_encode_field(&reg, static_cast<isd17xx_apc_field_t>(i), value[i]),
+                                     "isd17xx_apc_encode_field"); !res)
+                {
+                    return res;
+                }
+            }
+            
+            return check(isd17xx_apc_write(get(), reg), "isd17xx_apc_write");
+        }
+    
+    private:
+        /**
+         * @brief     wrap an initialized handle
+         * @param[in] handle owned handle
+         * @note      none
+         */
+        explicit Device(std::unique_ptr<isd17xx_handle_t> handle) noexcept : m_handle(std::move(handle)) {}
+        
+        /**
+         * @brief close the chip if this device owns one
+         * @note  deinit powers the chip down first
+         */
+        void close() noexcept
+        {
+            if (m_handle != nullptr)
+            {
+                (void)isd17xx_deinit(m_handle.get());
+                m_handle.reset();
+            }
+        }
+        
+        std::unique_ptr<isd17xx_handle_t> m_handle;    /**< owned handle */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
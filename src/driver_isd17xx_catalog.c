@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_catalog.c
+ * @brief     driver isd17xx catalog source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_catalog.h"
+
+/**
+ * @brief     get the free gap from an address
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] addr start address
+ * @return    free rows from addr to the next entry or the region end
+ * @note      0 means addr is used or out of the region
+ */
+static uint16_t a_isd17xx_catalog_gap(isd17xx_catalog_t *catalog, uint32_t addr)
+{
+    uint8_t i;
+    uint32_t next;
+    
+    if ((addr < catalog->start_addr) || (addr > catalog->end_addr))                                /* check the region */
+    {
+        return 0;                                                                                  /* out of the region */
+    }
+    next = (uint32_t)catalog->end_addr + 1;                                                        /* region end */
+    for (i = 0; i < ISD17XX_CATALOG_MAX_ENTRY; i++)                                                /* check all entries */
+    {
+        if (catalog->entry[i].used == 0)                                                           /* check the used flag */
+        {
+            continue;                                                                              /* skip */
+        }
+        if ((addr >= catalog->entry[i].start_addr) && (addr <= catalog->entry[i].end_addr))        /* check the address */
+        {
+            return 0;                                                                              /* used */
+        }
+        if ((catalog->entry[i].start_addr > addr) && (catalog->entry[i].start_addr < next))        /* check the next entry */
+        {
+            next = catalog->entry[i].start_addr;                                                   /* set the next */
+        }
+    }
+    
+    return (uint16_t)(next - addr);                                                                /* return the gap */
+}
+
+/**
+ * @brief     initialize the catalog
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr region start address
+ * @param[in] end_addr region end address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      none
+ */
+uint8_t isd17xx_catalog_init(isd17xx_catalog_t *catalog, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+{
+    if ((catalog == NULL) || (handle == NULL))                               /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((start_addr >= end_addr) || (end_addr > handle->end_address))        /* check the region */
+    {
+        handle->debug_print("isd17xx: region is invalid.\n");                /* region is invalid */
+        
+        return 4;                                                            /* return error */
+    }
+    
+    memset(catalog, 0, sizeof(isd17xx_catalog_t));                           /* clear the catalog */
+    catalog->handle = handle;                                                /* set the handle */
+    catalog->start_addr = start_addr;                                        /* set the start address */
+    catalog->end_addr = end_addr;                                            /* set the end address */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      allocate rows
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  rows row number
+ * @param[out] *id pointer to an entry id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rows is less than 2
+ *             - 5 catalog is full
+ *             - 6 no free range is large enough
+ * @note       the first free range that fits is used
+ */
+uint8_t isd17xx_catalog_alloc(isd17xx_catalog_t *catalog, uint16_t rows, uint8_t *id)
+{
+    uint8_t i;
+    uint8_t slot;
+    uint32_t addr;
+    uint32_t best;
+    
+    if ((catalog == NULL) || (catalog->handle == NULL))                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (catalog->handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (rows < 2)                                                                         /* check the rows */
+    {
+        catalog->handle->debug_print("isd17xx: rows is less than 2.\n");                  /* rows is less than 2 */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    slot = ISD17XX_CATALOG_MAX_ENTRY;                                                     /* init invalid */
+    for (i = 0; i < ISD17XX_CATALOG_MAX_ENTRY; i++)                                       /* find a free entry */
+    {
+        if (catalog->entry[i].used == 0)                                                  /* check the used flag */
+        {
+            slot = i;                                                                     /* set the slot */
+            
+            break;                                                                        /* break */
+        }
+    }
+    if (slot == ISD17XX_CATALOG_MAX_ENTRY)                                                /* check the slot */
+    {
+        catalog->handle->debug_print("isd17xx: catalog is full.\n");                      /* catalog is full */
+        
+        return 5;                                                                         /* return error */
+    }
+    
+    best = 0xFFFFFFFFU;                                                                   /* init invalid */
+    if (a_isd17xx_catalog_gap(catalog, catalog->start_addr) >= rows)                      /* check the region start */
+    {
+        best = catalog->start_addr;                                                       /* set the best */
+    }
+    for (i = 0; i < ISD17XX_CATALOG_MAX_ENTRY; i++)                                       /* check the end of all entries */
+    {
+        if (catalog->entry[i].used == 0)                                                  /* check the used flag */
+        {
+            continue;                                                                     /* skip */
+        }
+        addr = (uint32_t)catalog->entry[i].end_addr + 1;                                  /* get the address */
+        if ((addr < best) && (a_isd17xx_catalog_gap(catalog, addr) >= rows))              /* check the gap */
+        {
+            best = addr;                                                                  /* set the best */
+        }
+    }
+    if (best == 0xFFFFFFFFU)                                                              /* check the best */
+    {
+        catalog->handle->debug_print("isd17xx: no free range is large enough.\n");        /* no free range is large enough */
+        
+        return 6;                                                                         /* return error */
+    }
+    catalog->entry[slot].start_addr = (uint16_t)best;                                     /* set the start address */
+    catalog->entry[slot].end_addr = (uint16_t)(best + rows - 1);                          /* set the end address */
+    catalog->entry[slot].used = 1;                                                        /* set used */
+    *id = slot;                                                                           /* set the id */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     free an entry
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_catalog_free(isd17xx_catalog_t *catalog, uint8_t id)
+{
+    if ((catalog == NULL) || (catalog->handle == NULL))                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (catalog->handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if ((id >= ISD17XX_CATALOG_MAX_ENTRY) || (catalog->entry[id].used == 0))        /* check the id */
+    {
+        catalog->handle->debug_print("isd17xx: id is invalid.\n");                  /* id is invalid */
+        
+        return 4;                                                                   /* return error */
+    }
+    
+    catalog->entry[id].used = 0;                                                    /* clear used */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get an entry
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  id entry id
+ * @param[out] *start_addr pointer to a start address buffer
+ * @param[out] *end_addr pointer to an end address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 id is invalid
+ * @note       none
+ */
+uint8_t isd17xx_catalog_get_entry(isd17xx_catalog_t *catalog, uint8_t id, uint16_t *start_addr, uint16_t *end_addr)
+{
+    if ((catalog == NULL) || (catalog->handle == NULL))                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (catalog->handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if ((id >= ISD17XX_CATALOG_MAX_ENTRY) || (catalog->entry[id].used == 0))        /* check the id */
+    {
+        catalog->handle->debug_print("isd17xx: id is invalid.\n");                  /* id is invalid */
+        
+        return 4;                                                                   /* return error */
+    }
+    
+    *start_addr = catalog->entry[id].start_addr;                                    /* get the start address */
+    *end_addr = catalog->entry[id].end_addr;                                        /* get the end address */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the free capacity
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[out] *rows pointer to a free rows buffer
+ * @param[out] *largest pointer to a largest free range buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_catalog_get_free(isd17xx_catalog_t *catalog, uint16_t *rows, uint16_t *largest)
+{
+    uint8_t i;
+    uint16_t gap;
+    uint32_t total;
+    
+    if ((catalog == NULL) || (catalog->handle == NULL))                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (catalog->handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    total = (uint32_t)catalog->end_addr - catalog->start_addr + 1;                               /* get the region rows */
+    *largest = a_isd17xx_catalog_gap(catalog, catalog->start_addr);                              /* gap at the region start */
+    for (i = 0; i < ISD17XX_CATALOG_MAX_ENTRY; i++)                                              /* check all entries */
+    {
+        if (catalog->entry[i].used == 0)                                                         /* check the used flag */
+        {
+            continue;                                                                            /* skip */
+        }
+        total -= (uint32_t)catalog->entry[i].end_addr - catalog->entry[i].start_addr + 1;        /* remove the used rows */
+        gap = a_isd17xx_catalog_gap(catalog, (uint32_t)catalog->entry[i].end_addr + 1);          /* gap after the entry */
+        if (gap > *largest)                                                                      /* check the largest */
+        {
+            *largest = gap;                                                                      /* set the largest */
+        }
+    }
+    *rows = (uint16_t)total;                                                                     /* set the free rows */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     start recording an entry
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      the whole allocated range is given to set record
+ */
+uint8_t isd17xx_catalog_record(isd17xx_catalog_t *catalog, uint8_t id)
+{
+    if ((catalog == NULL) || (catalog->handle == NULL))                                                              /* check handle */
+    {
+        return 2;                                                                                                    /* return error */
+    }
+    if (catalog->handle->inited != 1)                                                                                /* check handle initialization */
+    {
+        return 3;                                                                                                    /* return error */
+    }
+    if ((id >= ISD17XX_CATALOG_MAX_ENTRY) || (catalog->entry[id].used == 0))                                         /* check the id */
+    {
+        catalog->handle->debug_print("isd17xx: id is invalid.\n");                                                   /* id is invalid */
+        
+        return 4;                                                                                                    /* return error */
+    }
+    
+    if (isd17xx_set_record(catalog->handle, catalog->entry[id].start_addr, catalog->entry[id].end_addr) != 0)        /* set record */
+    {
+        return 1;                                                                                                    /* return error */
+    }
+    
+    return 0;                                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      finish recording an entry and trim its tail
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  id entry id
+ * @param[out] *reclaimed pointer to a reclaimed rows buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 finish failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 id is invalid
+ * @note       call it after EOM or to stop early, the entry is shrunk to the
+ *             final record point and the unused rows go back to the free space
+ */
+uint8_t isd17xx_catalog_record_finish(isd17xx_catalog_t *catalog, uint8_t id, uint16_t *reclaimed)
+{
+    uint8_t status2;
+    uint16_t status1;
+    uint16_t point;
+    isd17xx_catalog_entry_t *entry;
+    
+    if ((catalog == NULL) || (catalog->handle == NULL))                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (catalog->handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if ((id >= ISD17XX_CATALOG_MAX_ENTRY) || (catalog->entry[id].used == 0))        /* check the id */
+    {
+        catalog->handle->debug_print("isd17xx: id is invalid.\n");                  /* id is invalid */
+        
+        return 4;                                                                   /* return error */
+    }
+    
+    entry = &catalog->entry[id];                                                    /* get the entry */
+    *reclaimed = 0;                                                                 /* init 0 */
+    if (isd17xx_get_status(catalog->handle, &status1, &status2) != 0)               /* get the status */
+    {
+        return 1;                                                                   /* return error */
+    }
+    if ((status2 & ISD17XX_STATUS2_REC) != 0)                                       /* check the record bit */
+    {
+        if (isd17xx_stop(catalog->handle) != 0)                                     /* stop early */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    if (isd17xx_read_record_point(catalog->handle, &point) != 0)                    /* read the final record point */
+    {
+        return 1;                                                                   /* return error */
+    }
+    if ((point <= entry->start_addr + 1) || (point > entry->end_addr))              /* check the point */
+    {
+        return 0;                                                                   /* nothing to trim */
+    }
+    *reclaimed = entry->end_addr - (point - 1);                                     /* get the unused rows */
+    entry->end_addr = point - 1;                                                    /* shrink to the used rows */
+    catalog->reclaimed_rows += *reclaimed;                                          /* add the reclaimed rows */
+    
+    return 0;                                                                       /* success return 0 */
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_catalog.h
+ * @brief     driver isd17xx catalog header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_CATALOG_H
+#define DRIVER_ISD17XX_CATALOG_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_catalog_driver isd17xx catalog driver function
+ * @brief    isd17xx catalog driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx catalog max definition
+ */
+#ifndef ISD17XX_CATALOG_MAX_ENTRY
+    #define ISD17XX_CATALOG_MAX_ENTRY        32        /**< max entry number */
+#endif
+
+/**
+ * @brief isd17xx catalog entry structure definition
+ */
+typedef struct isd17xx_catalog_entry_s
+{
+    uint16_t start_addr;       /**< start address */
+    uint16_t end_addr;         /**< end address */
+    uint8_t used;              /**< used flag */
+} isd17xx_catalog_entry_t;
+
+/**
+ * @brief isd17xx catalog structure definition
+ */
+typedef struct isd17xx_catalog_s
+{
+    isd17xx_handle_t *handle;                                        /**< isd17xx handle */
+    uint16_t start_addr;                                             /**< region start address */
+    uint16_t end_addr;                                               /**< region end address */
+    isd17xx_catalog_entry_t entry[ISD17XX_CATALOG_MAX_ENTRY];        /**< entries */
+    uint32_t reclaimed_rows;                                         /**< total reclaimed rows */
+} isd17xx_catalog_t;
+
+/**
+ * @brief     initialize the catalog
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr region start address
+ * @param[in] end_addr region end address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is invalid
+ * @note      none
+ */
+uint8_t isd17xx_catalog_init(isd17xx_catalog_t *catalog, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief      allocate rows
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  rows row number
+ * @param[out] *id pointer to an entry id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rows is less than 2
+ *             - 5 catalog is full
+ *             - 6 no free range is large enough
+ * @note       the first free range that fits is used
+ */
+uint8_t isd17xx_catalog_alloc(isd17xx_catalog_t *catalog, uint16_t rows, uint8_t *id);
+
+/**
+ * @brief     free an entry
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_catalog_free(isd17xx_catalog_t *catalog, uint8_t id);
+
+/**
+ * @brief      get an entry
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  id entry id
+ * @param[out] *start_addr pointer to a start address buffer
+ * @param[out] *end_addr pointer to an end address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 id is invalid
+ * @note       none
+ */
+uint8_t isd17xx_catalog_get_entry(isd17xx_catalog_t *catalog, uint8_t id, uint16_t *start_addr, uint16_t *end_addr);
+
+/**
+ * @brief      get the free capacity
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[out] *rows pointer to a free rows buffer
+ * @param[out] *largest pointer to a largest free range buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_catalog_get_free(isd17xx_catalog_t *catalog, uint16_t *rows, uint16_t *largest);
+
+/**
+ * @brief     start recording an entry
+ * @param[in] *catalog pointer to a catalog structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      the whole allocated range is given to set record
+ */
+uint8_t isd17xx_catalog_record(isd17xx_catalog_t *catalog, uint8_t id);
+
+/**
+ * @brief      finish recording an entry and trim its tail
+ * @param[in]  *catalog pointer to a catalog structure
+ * @param[in]  id entry id
+ * @param[out] *reclaimed pointer to a reclaimed rows buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 finish failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 id is invalid
+ * @note       call it after EOM or to stop early, the entry is shrunk to the
+ *             final record point and the unused rows go back to the free space
+ */
+uint8_t isd17xx_catalog_record_finish(isd17xx_catalog_t *catalog, uint8_t id, uint16_t *reclaimed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,449 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_cmdlist.c
+ * @brief     driver isd17xx cmdlist source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_cmdlist.h"
+
+/**
+ * @brief         send frames in as few transport calls as possible
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in]     *list pointer to a cmdlist structure
+ * @param[in,out] *seg pointer to a segment array
+ * @param[in]     num segment number
+ * @return        status code
+ *                - 0 success
+ *                - 1 transfer failed
+ * @note          none
+ */
+static uint8_t a_isd17xx_cmdlist_transfer(isd17xx_handle_t *handle, isd17xx_cmdlist_t *list,
+                                          isd17xx_spi_segment_t *seg, uint8_t num)
+{
+    if (handle->spi_transmit_vector != NULL)                                       /* check spi_transmit_vector */
+    {
+        list->transfer_count++;                                                    /* one call */
+    }
+    else
+    {
+        list->transfer_count += num;                                               /* one call per frame */
+    }
+    if (isd17xx_frame_transmit(handle, seg, num) != 0)                             /* send the frames */
+    {
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      read the status
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[in]  *list pointer to a cmdlist structure
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *status2 pointer to a status2 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_isd17xx_cmdlist_read_status(isd17xx_handle_t *handle, isd17xx_cmdlist_t *list,
+                                             uint16_t *status1, uint8_t *status2)
+{
+    uint8_t zero[2];
+    uint8_t buf[3];
+    uint8_t data[3];
+    isd17xx_spi_segment_t seg;
+    
+    zero[0] = 0x00;                                                                           /* set 0x00 */
+    zero[1] = 0x00;                                                                           /* set 0x00 */
+    (void)isd17xx_frame_encode(ISD17XX_COMMAND_RD_STATUS, zero, 2, buf);                      /* set read status command */
+    seg.tx = buf;                                                                             /* set the tx */
+    seg.rx = data;                                                                            /* set the rx */
+    seg.len = 3;                                                                              /* set 3 */
+    list->poll_count++;                                                                       /* one poll */
+    if (a_isd17xx_cmdlist_transfer(handle, list, &seg, 1) != 0)                               /* read the status */
+    {
+        return 1;                                                                             /* return error */
+    }
+    (void)isd17xx_frame_decode(data, 3);                                                      /* lsb to msb */
+    *status1 = ((uint16_t)data[0]) << 8 | data[1];                                            /* set the status1 */
+    *status2 = data[2];                                                                       /* set the status2 */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     clear the command list
+ * @param[in] *list pointer to a cmdlist structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ * @note      none
+ */
+uint8_t isd17xx_cmdlist_clear(isd17xx_cmdlist_t *list)
+{
+    if (list == NULL)                                   /* check list */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    memset(list, 0, sizeof(isd17xx_cmdlist_t));         /* clear the list */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     append a command
+ * @param[in] *list pointer to a cmdlist structure
+ * @param[in] command chip command
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @param[in] wait completion condition
+ * @param[in] timeout_ms completion timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ *            - 4 payload is too long
+ *            - 5 list is full
+ *            - 6 wait is invalid
+ * @note      the frame is encoded now with isd17xx_frame_encode, payload can be NULL when len is 0
+ */
+uint8_t isd17xx_cmdlist_add(isd17xx_cmdlist_t *list, uint8_t command, uint8_t *payload, uint8_t len,
+                            isd17xx_cmdlist_wait_t wait, uint16_t timeout_ms)
+{
+    isd17xx_cmdlist_entry_t *entry;
+    
+    if (list == NULL)                                                        /* check list */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (len > (ISD17XX_CMDLIST_MAX_FRAME - 1))                               /* check the length */
+    {
+        return 4;                                                            /* return error */
+    }
+    if (list->num >= ISD17XX_CMDLIST_MAX_ENTRY)                              /* check the num */
+    {
+        return 5;                                                            /* return error */
+    }
+    if (wait > ISD17XX_CMDLIST_WAIT_INT)                                     /* check the wait */
+    {
+        return 6;                                                            /* return error */
+    }
+    
+    entry = &list->entry[list->num];                                         /* get the entry */
+    (void)isd17xx_frame_encode(command, payload, len, entry->tx);            /* encode the frame */
+    entry->len = len + 1;                                                    /* set the frame length */
+    entry->wait = (uint8_t)wait;                                             /* set the wait */
+    entry->timeout_ms = timeout_ms;                                          /* set the timeout */
+    list->num++;                                                             /* num++ */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     append a set play, set record or set erase command
+ * @param[in] *list pointer to a cmdlist structure
+ * @param[in] command chip command
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @param[in] wait completion condition
+ * @param[in] timeout_ms completion timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ *            - 4 address is invalid
+ *            - 5 list is full
+ *            - 6 wait is invalid
+ *            - 7 command is invalid
+ * @note      none
+ */
+uint8_t isd17xx_cmdlist_add_address(isd17xx_cmdlist_t *list, uint8_t command, uint16_t start_addr, uint16_t end_addr,
+                                    isd17xx_cmdlist_wait_t wait, uint16_t timeout_ms)
+{
+    uint8_t res;
+    uint8_t buf[6];
+    
+    if (list == NULL)                                                                            /* check list */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if ((command < ISD17XX_COMMAND_SET_PLAY) ||
+        (command > ISD17XX_COMMAND_SET_ERASE))                                                   /* check the command */
+    {
+        return 7;                                                                                /* return error */
+    }
+    if ((start_addr >= end_addr) || (end_addr > 0x7FF))                                          /* check the address */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    buf[0] = 0x00;                                                                               /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                                  /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                                           /* set start address */
+    buf[3] = end_addr & 0xFF;                                                                    /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                                             /* set end address */
+    buf[5] = 0x00;                                                                               /* set 0x00 */
+    res = isd17xx_cmdlist_add(list, command, buf, 6, wait, timeout_ms);                          /* add the command */
+    
+    return res;                                                                                  /* return the result */
+}
+
+/**
+ * @brief     run the command list
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *list pointer to a cmdlist structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle or list is NULL
+ *            - 3 handle is not initialized
+ *            - 4 list is empty
+ *            - 5 command error
+ *            - 6 wait timeout
+ * @note      frames up to the next wait share one transport call when spi_transmit_vector is linked,
+ *            a clear interrupt frame leads the first batch so an interrupt pending before run
+ *            cannot end the first wait early, later interrupts are cleared with the next batch,
+ *            the status is only polled after a command with a wait,
+ *            a command error is seen in the status of the following frame or poll,
+ *            the status is read once more when the last command has no wait,
+ *            the message index is dropped, failed holds the index of the command that failed
+ */
+uint8_t isd17xx_cmdlist_run(isd17xx_handle_t *handle, isd17xx_cmdlist_t *list)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    uint8_t first;
+    uint8_t done;
+    uint8_t status2;
+    uint8_t clear;
+    uint8_t clear_tx[2];
+    uint8_t clear_rx[2];
+    uint8_t zero[1];
+    uint16_t status1;
+    uint64_t next;
+    uint64_t deadline;
+    isd17xx_cmdlist_entry_t *entry;
+    isd17xx_spi_segment_t seg[ISD17XX_SPI_SEGMENT_MAX];
+    
+    if ((handle == NULL) || (list == NULL))                                                       /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    if (list->num == 0)                                                                           /* check the num */
+    {
+        return 4;                                                                                 /* return error */
+    }
+    
+    list->transfer_count = 0;                                                                     /* clear the transfer count */
+    list->poll_count = 0;                                                                         /* clear the poll count */
+    list->failed = 0;                                                                             /* clear the failed index */
+    handle->message_index_valid = 0;                                                              /* the commands may change the memory */
+    zero[0] = 0x00;                                                                               /* set 0x00 */
+    clear = 1;                                                                                    /* drop an interrupt pending before run */
+    i = 0;                                                                                        /* init 0 */
+    while (i < list->num)                                                                         /* run all commands */
+    {
+        n = 0;                                                                                    /* init 0 */
+        if (clear != 0)                                                                           /* fold the clear interrupt */
+        {
+            (void)isd17xx_frame_encode(ISD17XX_COMMAND_CLR_INT, zero, 1, clear_tx);               /* set clear interrupt command */
+            seg[n].tx = clear_tx;                                                                 /* set the tx */
+            seg[n].rx = clear_rx;                                                                 /* set the rx */
+            seg[n].len = 2;                                                                       /* set 2 */
+            n++;                                                                                  /* n++ */
+            clear = 0;                                                                            /* cleared */
+        }
+        first = i;                                                                                /* first command of the batch */
+        while ((i < list->num) && (n < ISD17XX_SPI_SEGMENT_MAX))                                  /* pack the frames */
+        {
+            entry = &list->entry[i];                                                              /* get the entry */
+            seg[n].tx = entry->tx;                                                                /* set the tx */
+            seg[n].rx = entry->rx;                                                                /* set the rx */
+            seg[n].len = entry->len;                                                              /* set the length */
+            n++;                                                                                  /* n++ */
+            i++;                                                                                  /* i++ */
+            if (entry->wait != ISD17XX_CMDLIST_WAIT_NONE)                                         /* the chip must finish first */
+            {
+                break;                                                                            /* break */
+            }
+        }
+        if (a_isd17xx_cmdlist_transfer(handle, list, seg, n) != 0)                                /* send the batch */
+        {
+            list->failed = first;                                                                 /* set the failed index */
+            handle->debug_print("isd17xx: cmdlist transfer failed.\n");                           /* cmdlist transfer failed */
+            
+            return 1;                                                                             /* return error */
+        }
+        for (j = first; j < i; j++)                                                               /* decode the responses */
+        {
+            entry = &list->entry[j];                                                              /* get the entry */
+            (void)isd17xx_frame_decode(entry->rx, entry->len);                                    /* lsb to msb */
+            if ((j != first) && ((entry->rx[1] & ISD17XX_STATUS1_CMD_ERR) != 0))                  /* the previous command failed */
+            {
+                list->failed = j - 1;                                                             /* set the failed index */
+                handle->debug_print("isd17xx: command error.\n");                                 /* command error */
+                
+                return 5;                                                                         /* return error */
+            }
+        }
+        
+        entry = &list->entry[i - 1];                                                              /* last command of the batch */
+        if (entry->wait == ISD17XX_CMDLIST_WAIT_NONE)                                             /* no wait */
+        {
+            if (i == list->num)                                                                   /* the last command */
+            {
+                if (a_isd17xx_cmdlist_read_status(handle, list, &status1, &status2) != 0)         /* read the status once */
+                {
+                    list->failed = i - 1;                                                         /* set the failed index */
+                    handle->debug_print("isd17xx: get status failed.\n");                         /* get status failed */
+                    
+                    return 1;                                                                     /* return error */
+                }
+                if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)                                     /* check the command error */
+                {
+                    list->failed = i - 1;                                                         /* set the failed index */
+                    handle->debug_print("isd17xx: command error.\n");                             /* command error */
+                    
+                    return 5;                                                                     /* return error */
+                }
+                if ((status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)                 /* check the eom and int */
+                {
+                    clear = 1;                                                                    /* clear it at the end */
+                }
+            }
+            
+            continue;                                                                             /* next batch */
+        }
+        (void)isd17xx_get_clock(handle, &next);                                                   /* poll from now */
+        deadline = next + (uint64_t)entry->timeout_ms * 1000;                                     /* set the deadline */
+        while (1)                                                                                 /* poll the status */
+        {
+            if (a_isd17xx_cmdlist_read_status(handle, list, &status1, &status2) != 0)             /* read the status */
+            {
+                list->failed = i - 1;                                                             /* set the failed index */
+                handle->debug_print("isd17xx: get status failed.\n");                             /* get status failed */
+                
+                return 1;                                                                         /* return error */
+            }
+            if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)                                         /* check the command error */
+            {
+                list->failed = i - 1;                                                             /* set the failed index */
+                handle->debug_print("isd17xx: command error.\n");                                 /* command error */
+                
+                return 5;                                                                         /* return error */
+            }
+            if ((status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)                     /* check the eom and int */
+            {
+                clear = 1;                                                                        /* clear it with the next batch */
+            }
+            if (entry->wait == ISD17XX_CMDLIST_WAIT_READY)                                        /* wait ready */
+            {
+                done = ((status2 & ISD17XX_STATUS2_RDY) != 0) ? 1 : 0;                            /* check ready */
+            }
+            else if (entry->wait == ISD17XX_CMDLIST_WAIT_IDLE)                                    /* wait idle */
+            {
+                done = (((status2 & ISD17XX_STATUS2_RDY) != 0) &&
+                        ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC |
+                                     ISD17XX_STATUS2_ERASE)) == 0)) ? 1 : 0;                      /* check idle */
+            }
+            else
+            {
+                done = ((status1 & ISD17XX_STATUS1_INT) != 0) ? 1 : 0;                            /* check int */
+            }
+            if (done != 0)                                                                        /* check done */
+            {
+                break;                                                                            /* break */
+            }
+            if (next >= deadline)                                                                 /* check the timeout */
+            {
+                list->failed = i - 1;                                                             /* set the failed index */
+                handle->debug_print("isd17xx: wait timeout.\n");                                  /* wait timeout */
+                
+                return 6;                                                                         /* return error */
+            }
+            next += 1000;                                                                         /* next poll in 1ms */
+            (void)isd17xx_delay_until(handle, next);                                              /* delay until the next poll */
+        }
+    }
+    if (clear != 0)                                                                               /* interrupt still pending */
+    {
+        (void)isd17xx_frame_encode(ISD17XX_COMMAND_CLR_INT, zero, 1, clear_tx);                   /* set clear interrupt command */
+        seg[0].tx = clear_tx;                                                                     /* set the tx */
+        seg[0].rx = clear_rx;                                                                     /* set the rx */
+        seg[0].len = 2;                                                                           /* set 2 */
+        if (a_isd17xx_cmdlist_transfer(handle, list, seg, 1) != 0)                                /* clear interrupt */
+        {
+            handle->debug_print("isd17xx: set clear interrupt failed.\n");                        /* set clear interrupt failed */
+            
+            return 1;                                                                             /* return error */
+        }
+    }
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the response of a command
+ * @param[in]  *list pointer to a cmdlist structure
+ * @param[in]  index command index
+ * @param[out] *buf pointer to a response buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 list is NULL
+ *             - 4 index is invalid
+ * @note       the response starts with the two status1 bytes and is valid after run,
+ *             buf must hold ISD17XX_CMDLIST_MAX_FRAME bytes
+ */
+uint8_t isd17xx_cmdlist_get_response(isd17xx_cmdlist_t *list, uint8_t index, uint8_t *buf, uint8_t *len)
+{
+    if (list == NULL)                                                       /* check list */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (index >= list->num)                                                 /* check the index */
+    {
+        return 4;                                                           /* return error */
+    }
+    
+    memcpy(buf, list->entry[index].rx, list->entry[index].len);             /* copy the response */
+    *len = list->entry[index].len;                                          /* set the length */
+    
+    return 0;                                                               /* success return 0 */
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_cmdlist.h
+ * @brief     driver isd17xx cmdlist header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_CMDLIST_H
+#define DRIVER_ISD17XX_CMDLIST_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_cmdlist_driver isd17xx cmdlist driver function
+ * @brief    isd17xx cmdlist driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx cmdlist max definition
+ */
+#ifndef ISD17XX_CMDLIST_MAX_ENTRY
+    #define ISD17XX_CMDLIST_MAX_ENTRY        16        /**< max command number */
+#endif
+#ifndef ISD17XX_CMDLIST_MAX_FRAME
+    #define ISD17XX_CMDLIST_MAX_FRAME        8         /**< max frame length including the command */
+#endif
+
+/**
+ * @brief isd17xx cmdlist wait enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_CMDLIST_WAIT_NONE  = 0x00,        /**< the next frame follows at once */
+    ISD17XX_CMDLIST_WAIT_READY = 0x01,        /**< wait until ready is set */
+    ISD17XX_CMDLIST_WAIT_IDLE  = 0x02,        /**< wait until ready is set and play, record and erase are clear */
+    ISD17XX_CMDLIST_WAIT_INT   = 0x03,        /**< wait until the operation raises int */
+} isd17xx_cmdlist_wait_t;
+
+/**
+ * @brief isd17xx cmdlist entry structure definition
+ */
+typedef struct isd17xx_cmdlist_entry_s
+{
+    uint8_t tx[ISD17XX_CMDLIST_MAX_FRAME];        /**< encoded frame */
+    uint8_t rx[ISD17XX_CMDLIST_MAX_FRAME];        /**< response frame */
+    uint8_t len;                                  /**< frame length */
+    uint8_t wait;                                 /**< completion condition */
+    uint16_t timeout_ms;                          /**< completion timeout in ms */
+} isd17xx_cmdlist_entry_t;
+
+/**
+ * @brief isd17xx cmdlist structure definition
+ */
+typedef struct isd17xx_cmdlist_s
+{
+    isd17xx_cmdlist_entry_t entry[ISD17XX_CMDLIST_MAX_ENTRY];        /**< commands */
+    uint8_t num;                                                     /**< command number */
+    uint8_t failed;                                                  /**< index of the failed command */
+    uint16_t transfer_count;                                         /**< transport calls of the last run */
+    uint16_t poll_count;                                             /**< status polls of the last run */
+} isd17xx_cmdlist_t;
+
+/**
+ * @brief     clear the command list
+ * @param[in] *list pointer to a cmdlist structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ * @note      none
+ */
+uint8_t isd17xx_cmdlist_clear(isd17xx_cmdlist_t *list);
+
+/**
+ * @brief     append a command
+ * @param[in] *list pointer to a cmdlist structure
+ * @param[in] command chip command
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @param[in] wait completion condition
+ * @param[in] timeout_ms completion timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ *            - 4 payload is too long
+ *            - 5 list is full
+ *            - 6 wait is invalid
+ * @note      the frame is encoded now with isd17xx_frame_encode, payload can be NULL when len is 0
+ */
+uint8_t isd17xx_cmdlist_add(isd17xx_cmdlist_t *list, uint8_t command, uint8_t *payload, uint8_t len,
+                            isd17xx_cmdlist_wait_t wait, uint16_t timeout_ms);
+
+/**
+ * @brief     append a set play, set record or set erase command
+ * @param[in] *list pointer to a cmdlist structure
+ * @param[in] command chip command
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @param[in] wait completion condition
+ * @param[in] timeout_ms completion timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 list is NULL
+ *            - 4 address is invalid
+ *            - 5 list is full
+ *            - 6 wait is invalid
+ *            - 7 command is invalid
+ * @note      none
+ */
+uint8_t isd17xx_cmdlist_add_address(isd17xx_cmdlist_t *list, uint8_t command, uint16_t start_addr, uint16_t end_addr,
+                                    isd17xx_cmdlist_wait_t wait, uint16_t timeout_ms);
+
+/**
+ * @brief     run the command list
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *list pointer to a cmdlist structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle or list is NULL
+ *            - 3 handle is not initialized
+ *            - 4 list is empty
+ *            - 5 command error
+ *            - 6 wait timeout
+ * @note      frames up to the next wait share one transport call when spi_transmit_vector is linked,
+ *            a clear interrupt frame leads the first batch so an interrupt pending before run
+ *            cannot end the first wait early, later interrupts are cleared with the next batch,
+ *            the status is only polled after a command with a wait,
+ *            a command error is seen in the status of the following frame or poll,
+ *            the status is read once more when the last command has no wait,
+ *            the message index is dropped, failed holds the index of the command that failed
+ */
+uint8_t isd17xx_cmdlist_run(isd17xx_handle_t *handle, isd17xx_cmdlist_t *list);
+
+/**
+ * @brief      get the response of a command
+ * @param[in]  *list pointer to a cmdlist structure
+ * @param[in]  index command index
+ * @param[out] *buf pointer to a response buffer
+ * @param[out] *len pointer to a length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 list is NULL
+ *             - 4 index is invalid
+ * @note       the response starts with the two status1 bytes and is valid after run,
+ *             buf must hold ISD17XX_CMDLIST_MAX_FRAME bytes
+ */
+uint8_t isd17xx_cmdlist_get_response(isd17xx_cmdlist_t *list, uint8_t index, uint8_t *buf, uint8_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,532 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_coro.hpp
+ * @brief     driver isd17xx c++ coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_CORO_HPP
+#define DRIVER_ISD17XX_CORO_HPP
+
+#include "driver_isd17xx.hpp"
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+/**
+ * @defgroup isd17xx_coro_driver isd17xx coroutine driver function
+ * @brief    isd17xx coroutine driver modules
+ * @ingroup  isd17xx_driver
+ * @note     header only, needs c++20
+ * @{
+ */
+
+namespace isd17xx
+{
+
+/**
+ * @brief coroutine error code definition
+ * @note  outside the range of the c status codes
+ */
+inline constexpr uint8_t ERROR_BUSY = 0xFE;         /**< the device already has a pending operation */
+inline constexpr uint8_t ERROR_CANCELLED = 0xFF;    /**< the operation was cancelled */
+
+class Loop;
+
+/**
+ * @brief awaitable operation class definition
+ * @note  created by Loop::play, Loop::record and Loop::erase, the command is sent
+ *        when the operation is awaited and the awaiting coroutine is resumed by the loop
+ *        once the chip raises int
+ */
+class [[nodiscard]] Operation
+{
+    public:
+        /**
+         * @brief operation kind enumeration definition
+         */
+        enum class Kind : uint8_t
+        {
+            PLAY = 0,      /**< set play */
+            RECORD = 1,    /**< set record */
+            ERASE = 2,     /**< set erase */
+        };
+        
+        /**
+         * @brief     make an operation
+         * @param[in] *loop pointer to the servicing loop
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @param[in] kind operation kind
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @note      nothing is sent until the operation is awaited
+         */
+        Operation(Loop *loop, isd17xx_handle_t *handle, Kind kind, uint16_t start_addr, uint16_t end_addr) noexcept
+            : m_loop(loop), m_handle(handle), m_kind(kind), m_start_addr(start_addr), m_end_addr(end_addr) {}
+        
+        Operation(const Operation &) = delete;
+        Operation &operator=(const Operation &) = delete;
+        
+        /**
+         * @brief  check if the operation can complete without suspending
+         * @return false
+         * @note   none
+         */
+        bool await_ready() const noexcept { return false; }
+        
+        /**
+         * @brief     send the command and park the coroutine on the loop
+         * @param[in] waiter awaiting coroutine
+         * @return    true if the coroutine is suspended
+         * @note      defined after Loop
+         */
+        bool await_suspend(std::coroutine_handle<> waiter) noexcept;
+        
+        /**
+         * @brief  get the operation result
+         * @return result
+         * @note   none
+         */
+        Result<void> await_resume() const noexcept { return m_result; }
+    
+    private:
+        friend class Loop;
+        
+        Loop *m_loop;                        /**< servicing loop */
+        isd17xx_handle_t *m_handle;          /**< device handle */
+        Kind m_kind;                         /**< operation kind */
+        uint16_t m_start_addr;               /**< start address */
+        uint16_t m_end_addr;                 /**< end address */
+        Result<void> m_result;               /**< operation result */
+        std::coroutine_handle<> m_waiter;    /**< awaiting coroutine */
+};
+
+/**
+ * @brief single thread device loop class definition
+ * @note  one loop services any number of devices, each device may have one pending operation,
+ *        call service when a device int line fires or poll from a timer when no int line is wired,
+ *        both cost one clear interrupt frame per device
+ */
+class Loop
+{
+    public:
+        Loop() = default;
+        Loop(const Loop &) = delete;
+        Loop &operator=(const Loop &) = delete;
+        
+        /**
+         * @brief cancel every pending operation
+         * @note  the awaiting coroutines are resumed with ERROR_CANCELLED
+         */
+        ~Loop() { cancel_all(); }
+        
+        /**
+         * @brief     make a play operation
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        Operation play(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return Operation(this, handle, Operation::Kind::PLAY, start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     make a record operation
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        Operation record(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return Operation(this, handle, Operation::Kind::RECORD, start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     make an erase operation
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        Operation erase(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return Operation(this, handle, Operation::Kind::ERASE, start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     make a play operation on a device
+         * @param[in] &device device
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        template <class Transport>
+        Operation play(Device<Transport> &device, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return play(device.get(), start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     make a record operation on a device
+         * @param[in] &device device
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        template <class Transport>
+        Operation record(Device<Transport> &device, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return record(device.get(), start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     make an erase operation on a device
+         * @param[in] &device device
+         * @param[in] start_addr start address
+         * @param[in] end_addr end address
+         * @return    awaitable operation
+         * @note      none
+         */
+        template <class Transport>
+        Operation erase(Device<Transport> &device, uint16_t start_addr, uint16_t end_addr) noexcept
+        {
+            return erase(device.get(), start_addr, end_addr);
+        }
+        
+        /**
+         * @brief     service one device
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @return    number of resumed coroutines
+         * @note      call when the device int line fires, the interrupt is always cleared
+         */
+        size_t service(isd17xx_handle_t *handle)
+        {
+            std::vector<Operation *> ready;
+            
+            for (size_t i = 0; i < m_pending.size(); )
+            {
+                if ((m_pending[i]->m_handle == handle) && a_check(m_pending[i]))
+                {
+                    ready.push_back(m_pending[i]);
+                    m_pending[i] = m_pending.back();
+                    m_pending.pop_back();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            
+            return a_resume(ready);
+        }
+        
+        /**
+         * @brief  service every device with a pending operation
+         * @return number of resumed coroutines
+         * @note   call from a periodic timer when the int lines are not wired
+         */
+        size_t poll()
+        {
+            std::vector<Operation *> ready;
+            
+            for (size_t i = 0; i < m_pending.size(); )
+            {
+                if (a_check(m_pending[i]))
+                {
+                    ready.push_back(m_pending[i]);
+                    m_pending[i] = m_pending.back();
+                    m_pending.pop_back();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            
+            return a_resume(ready);
+        }
+        
+        /**
+         * @brief     cancel the pending operation of a device
+         * @param[in] *handle pointer to an isd17xx handle structure
+         * @return    true if an operation was cancelled
+         * @note      the chip is stopped and the awaiting coroutine is resumed with ERROR_CANCELLED
+         */
+        bool cancel(isd17xx_handle_t *handle)
+        {
+            std::vector<Operation *> ready;
+            
+            for (size_t i = 0; i < m_pending.size(); i++)
+            {
+                if (m_pending[i]->m_handle == handle)
+                {
+                    a_stop(m_pending[i]);
+                    ready.push_back(m_pending[i]);
+                    m_pending[i] = m_pending.back();
+                    m_pending.pop_back();
+                    
+                    break;
+                }
+            }
+            
+            return a_resume(ready) != 0;
+        }
+        
+        /**
+         * @brief  cancel every pending operation
+         * @return number of cancelled operations
+         * @note   none
+         */
+        size_t cancel_all()
+        {
+            std::vector<Operation *> ready;
+            
+            ready.swap(m_pending);
+            for (Operation *op : ready)
+            {
+                a_stop(op);
+            }
+            
+            return a_resume(ready);
+        }
+        
+        /**
+         * @brief  get the pending operation number
+         * @return pending operation number
+         * @note   none
+         */
+        size_t pending() const noexcept { return m_pending.size(); }
+    
+    private:
+        friend class Operation;
+        
+        /**
+         * @brief     start an operation
+         * @param[in] *op pointer to an operation
+         * @return    true if the operation is pending
+         * @note      a stale interrupt is cleared first so it can not complete the new operation,
+         *            the command delay is skipped because completion is reported by the int bit
+         */
+        bool a_start(Operation *op) noexcept
+        {
+            uint16_t status1;
+            uint16_t command_delay;
+            uint8_t res;
+            
+            for (Operation *p : m_pending)
+            {
+                if (p->m_handle == op->m_handle)
+                {
+                    op->m_result = Error{ERROR_BUSY, "isd17xx::Loop"};
+                    
+                    return false;
+                }
+            }
+            res = isd17xx_irq_service(op->m_handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, nullptr);
+            if (res != 0)
+            {
+                op->m_result = Error{res, "isd17xx_irq_service"};
+                
+                return false;
+            }
+            command_delay = op->m_handle->command_delay;
+            op->m_handle->command_delay = 0;
+            if (op->m_kind == Operation::Kind::PLAY)
+            {
+                op->m_result = check(isd17xx_set_play(op->m_handle, op->m_start_addr, op->m_end_addr), "isd17xx_set_play");
+            }
+            else if (op->m_kind == Operation::Kind::RECORD)
+            {
+                op->m_result = check(isd17xx_set_record(op->m_handle, op->m_start_addr, op->m_end_addr), "isd17xx_set_record");
+            }
+            else
+            {
+                op->m_result = check(isd17xx_set_erase(op->m_handle, op->m_start_addr, op->m_end_addr), "isd17xx_set_erase");
+            }
+            op->m_handle->command_delay = command_delay;
+            if (!op->m_result)
+            {
+                return false;
+            }
+            m_pending.push_back(op);
+            
+            return true;
+        }
+        
+        /**
+         * @brief     check if an operation has completed
+         * @param[in] *op pointer to an operation
+         * @return    true if completed
+         * @note      status1 is read by the clear interrupt frame, so int is seen and cleared at once
+         */
+        static bool a_check(Operation *op) noexcept
+        {
+            uint16_t status1;
+            uint8_t res;
+            
+            res = isd17xx_irq_service(op->m_handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, nullptr);
+            if (res != 0)
+            {
+                op->m_result = Error{res, "isd17xx_irq_service"};
+                
+                return true;
+            }
+            if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)
+            {
+                op->m_result = Error{1, "isd17xx_irq_service"};
+                
+                return true;
+            }
+            
+            return (status1 & ISD17XX_STATUS1_INT) != 0;
+        }
+        
+        /**
+         * @brief     stop a pending operation
+         * @param[in] *op pointer to an operation
+         * @note      the stop is sent as a raw frame so cancelling never sleeps,
+         *            a late stop interrupt is cleared by the next start
+         */
+        static void a_stop(Operation *op) noexcept
+        {
+            uint16_t status1;
+            
+            (void)isd17xx_send_command(op->m_handle, ISD17XX_COMMAND_STOP, &status1);
+            (void)isd17xx_irq_service(op->m_handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, nullptr);
+            op->m_result = Error{ERROR_CANCELLED, "isd17xx::Loop"};
+        }
+        
+        /**
+         * @brief     resume the completed operations
+         * @param[in] &ready completed operations
+         * @return    number of resumed coroutines
+         * @note      resumed after they left the pending list, so a coroutine may start its next operation
+         */
+        static size_t a_resume(std::vector<Operation *> &ready)
+        {
+            for (Operation *op : ready)
+            {
+                op->m_waiter.resume();
+            }
+            
+            return ready.size();
+        }
+        
+        std::vector<Operation *> m_pending;    /**< pending operations */
+};
+
+inline bool Operation::await_suspend(std::coroutine_handle<> waiter) noexcept
+{
+    m_waiter = waiter;
+    
+    return m_loop->a_start(this);
+}
+
+/**
+ * @brief eager coroutine task class definition
+ * @note  the body runs until its first co_await, the task owns the frame
+ *        and must outlive any operation it is awaiting
+ */
+class [[nodiscard]] Task
+{
+    public:
+        /**
+         * @brief task promise structure definition
+         */
+        struct promise_type
+        {
+            Result<void> result;    /**< returned result */
+            
+            Task get_return_object() noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_value(Result<void> value) noexcept { result = value; }
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+        
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+        
+        /**
+         * @brief     move a task
+         * @param[in] other moved from task
+         * @note      none
+         */
+        Task(Task &&other) noexcept : m_coro(other.m_coro) { other.m_coro = nullptr; }
+        
+        /**
+         * @brief destroy the coroutine frame
+         * @note  none
+         */
+        ~Task()
+        {
+            if (m_coro)
+            {
+                m_coro.destroy();
+            }
+        }
+        
+        /**
+         * @brief  check if the body has finished
+         * @return true if finished
+         * @note   none
+         */
+        bool done() const noexcept { return m_coro && m_coro.done(); }
+        
+        /**
+         * @brief  get the returned result
+         * @return result
+         * @note   only valid when done is true
+         */
+        Result<void> result() const noexcept { return m_coro.promise().result; }
+    
+    private:
+        explicit Task(std::coroutine_handle<promise_type> coro) noexcept : m_coro(coro) {}
+        
+        std::coroutine_handle<promise_type> m_coro;    /**< coroutine frame */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,579 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_loop.c
+ * @brief     driver isd17xx loop source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_loop.h"
+#include "driver_isd17xx_phrase.h"
+
+/**
+ * @brief     wait a status2 bit
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] mask status2 bit mask
+ * @param[in] level wanted level
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 get status failed
+ *            - 5 timeout
+ * @note      none
+ */
+static uint8_t a_isd17xx_loop_wait(isd17xx_handle_t *handle, uint8_t mask, uint8_t level, uint32_t timeout_ms)
+{
+    uint8_t status2;
+    uint16_t status1;
+    uint64_t next;
+    uint64_t deadline;
+    
+    (void)isd17xx_get_clock(handle, &next);                             /* poll from now */
+    deadline = next + (uint64_t)timeout_ms * 1000;                      /* set the deadline */
+    while (1)                                                           /* loop */
+    {
+        if (isd17xx_get_status(handle, &status1, &status2) != 0)        /* get the status */
+        {
+            return 1;                                                   /* return error */
+        }
+        if ((((status2 & mask) != 0) ? 1 : 0) == level)                 /* check the level */
+        {
+            return 0;                                                   /* success return 0 */
+        }
+        if (next >= deadline)                                           /* check the timeout */
+        {
+            handle->debug_print("isd17xx: timeout.\n");                 /* timeout */
+            
+            return 5;                                                   /* return error */
+        }
+        next += 1000;                                                   /* next poll in 1ms */
+        (void)isd17xx_delay_until(handle, next);                        /* delay until the next poll */
+    }
+}
+
+/**
+ * @brief     erase a slot
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] index slot index
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      none
+ */
+static uint8_t a_isd17xx_loop_erase(isd17xx_loop_t *loop, uint8_t index)
+{
+    isd17xx_loop_slot_t *slot;
+    
+    slot = &loop->slot[index];                                                                         /* get the slot */
+    slot->state = ISD17XX_LOOP_SLOT_DIRTY;                                                             /* drop the audio */
+    if (isd17xx_set_erase(loop->handle, slot->start_addr, slot->end_addr) != 0)                        /* set erase */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    if (a_isd17xx_loop_wait(loop->handle, ISD17XX_STATUS2_RDY, 1, ISD17XX_LOOP_TIMEOUT) != 0)          /* wait ready */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    if (a_isd17xx_loop_wait(loop->handle, ISD17XX_STATUS2_ERASE, 0, ISD17XX_LOOP_TIMEOUT) != 0)        /* wait the erase end */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    slot->state = ISD17XX_LOOP_SLOT_ERASED;                                                            /* erased */
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     start recording a slot
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] index slot index
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ * @note      a slot not erased ahead is erased first and counted as a miss
+ */
+static uint8_t a_isd17xx_loop_record(isd17xx_loop_t *loop, uint8_t index)
+{
+    isd17xx_loop_slot_t *slot;
+    
+    slot = &loop->slot[index];                                                                       /* get the slot */
+    if (slot->state != ISD17XX_LOOP_SLOT_ERASED)                                                     /* check the state */
+    {
+        loop->erase_miss_count++;                                                                    /* erase miss count++ */
+        if (a_isd17xx_loop_erase(loop, index) != 0)                                                  /* erase inline */
+        {
+            return 1;                                                                                /* return error */
+        }
+    }
+    slot->state = ISD17XX_LOOP_SLOT_DIRTY;                                                           /* the slot is being written */
+    if (isd17xx_set_record(loop->handle, slot->start_addr, slot->end_addr) != 0)                     /* set record */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    if (a_isd17xx_loop_wait(loop->handle, ISD17XX_STATUS2_REC, 1, ISD17XX_LOOP_TIMEOUT) != 0)        /* wait the record start */
+    {
+        return 1;                                                                                    /* return error */
+    }
+    slot->start_us = loop->handle->get_time_us();                                                    /* set the start timestamp */
+    slot->end_us = slot->start_us;                                                                   /* set the end timestamp */
+    slot->used_addr = slot->start_addr;                                                              /* set the used address */
+    slot->state = ISD17XX_LOOP_SLOT_RECORDING;                                                       /* recording */
+    loop->current = index;                                                                           /* set the current slot */
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     initialize the loop recorder
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr region start address
+ * @param[in] end_addr region end address
+ * @param[in] slot_num slot number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_us is NULL
+ *            - 5 region or slot number is invalid
+ * @note      every slot needs at least two rows
+ */
+uint8_t isd17xx_loop_init(isd17xx_loop_t *loop, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr, uint8_t slot_num)
+{
+    uint8_t i;
+    uint16_t rows;
+    uint16_t step;
+    
+    if ((loop == NULL) || (handle == NULL))                                         /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if (handle->get_time_us == NULL)                                                /* check get_time_us */
+    {
+        handle->debug_print("isd17xx: get_time_us is null.\n");                     /* get_time_us is null */
+        
+        return 4;                                                                   /* return error */
+    }
+    if ((start_addr >= end_addr) || (end_addr > handle->end_address) ||
+        (slot_num == 0) || (slot_num > ISD17XX_LOOP_MAX_SLOT))                      /* check the param */
+    {
+        handle->debug_print("isd17xx: region or slot number is invalid.\n");        /* region or slot number is invalid */
+        
+        return 5;                                                                   /* return error */
+    }
+    rows = end_addr - start_addr + 1;                                               /* get the rows */
+    step = rows / slot_num;                                                         /* get the slot rows */
+    if (step < 2)                                                                   /* check the slot rows */
+    {
+        handle->debug_print("isd17xx: region or slot number is invalid.\n");        /* region or slot number is invalid */
+        
+        return 5;                                                                   /* return error */
+    }
+    
+    memset(loop, 0, sizeof(isd17xx_loop_t));                                        /* clear the loop */
+    loop->handle = handle;                                                          /* set the handle */
+    loop->slot_num = slot_num;                                                      /* set the slot number */
+    loop->current = slot_num - 1;                                                   /* the first record goes to slot 0 */
+    for (i = 0; i < slot_num; i++)                                                  /* split the region */
+    {
+        loop->slot[i].start_addr = start_addr + step * i;                           /* set the start address */
+        loop->slot[i].end_addr = loop->slot[i].start_addr + step - 1;               /* set the end address */
+        loop->slot[i].used_addr = loop->slot[i].start_addr;                         /* set the used address */
+        loop->slot[i].state = ISD17XX_LOOP_SLOT_DIRTY;                              /* unknown content */
+    }
+    loop->slot[slot_num - 1].end_addr = end_addr;                                   /* the last slot takes the remainder */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     start the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 loop is running
+ * @note      recording continues in the slot after the newest one
+ */
+uint8_t isd17xx_loop_start(isd17xx_loop_t *loop)
+{
+    uint8_t res;
+    uint16_t command_delay;
+    
+    if ((loop == NULL) || (loop->handle == NULL))                                   /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (loop->handle->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if (loop->running != 0)                                                         /* check the running */
+    {
+        loop->handle->debug_print("isd17xx: loop is running.\n");                   /* loop is running */
+        
+        return 6;                                                                   /* return error */
+    }
+    
+    command_delay = loop->handle->command_delay;                                    /* save the command delay */
+    loop->handle->command_delay = 0;                                                /* poll instead of delay */
+    res = a_isd17xx_loop_record(loop, (loop->current + 1) % loop->slot_num);        /* record the next slot */
+    loop->handle->command_delay = command_delay;                                    /* restore the command delay */
+    if (res != 0)                                                                   /* check the result */
+    {
+        return 1;                                                                   /* return error */
+    }
+    loop->running = 1;                                                              /* set running */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     poll the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it faster than one slot time, the end of a slot is detected
+ *            from the record bit and the next slot is started at once
+ */
+uint8_t isd17xx_loop_poll(isd17xx_loop_t *loop)
+{
+    uint8_t res;
+    uint8_t status2;
+    uint16_t status1;
+    uint16_t command_delay;
+    uint64_t t0;
+    uint64_t dead;
+    isd17xx_loop_slot_t *slot;
+    
+    if ((loop == NULL) || (loop->handle == NULL))                                    /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (loop->handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (loop->running == 0)                                                          /* check the running */
+    {
+        return 0;                                                                    /* success return 0 */
+    }
+    
+    if (isd17xx_get_status(loop->handle, &status1, &status2) != 0)                   /* get the status */
+    {
+        return 1;                                                                    /* return error */
+    }
+    if ((status2 & ISD17XX_STATUS2_REC) != 0)                                        /* check the record bit */
+    {
+        return 0;                                                                    /* still recording */
+    }
+    
+    t0 = loop->handle->get_time_us();                                                /* get the slot end time */
+    slot = &loop->slot[loop->current];                                               /* get the current slot */
+    slot->used_addr = slot->end_addr;                                                /* the slot is full */
+    slot->end_us = t0;                                                               /* set the end timestamp */
+    slot->state = ISD17XX_LOOP_SLOT_FULL;                                            /* holds audio */
+    command_delay = loop->handle->command_delay;                                     /* save the command delay */
+    loop->handle->command_delay = 0;                                                 /* poll instead of delay */
+    res = a_isd17xx_loop_record(loop, (loop->current + 1) % loop->slot_num);         /* roll over */
+    loop->handle->command_delay = command_delay;                                     /* restore the command delay */
+    if (res != 0)                                                                    /* check the result */
+    {
+        loop->running = 0;                                                           /* stop running */
+        
+        return 1;                                                                    /* return error */
+    }
+    dead = loop->handle->get_time_us() - t0;                                         /* get the dead time */
+    loop->last_dead_us = (dead > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)dead;        /* set the last dead time */
+    if (loop->last_dead_us > loop->max_dead_us)                                      /* check the max dead time */
+    {
+        loop->max_dead_us = loop->last_dead_us;                                      /* set the max dead time */
+    }
+    loop->rollover_count++;                                                          /* rollover count++ */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     stop the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the current slot is cut at the final record point
+ */
+uint8_t isd17xx_loop_stop(isd17xx_loop_t *loop)
+{
+    uint16_t point;
+    isd17xx_loop_slot_t *slot;
+    
+    if ((loop == NULL) || (loop->handle == NULL))                           /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (loop->handle->inited != 1)                                          /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (loop->running == 0)                                                 /* check the running */
+    {
+        return 0;                                                           /* success return 0 */
+    }
+    
+    loop->running = 0;                                                      /* clear running */
+    slot = &loop->slot[loop->current];                                      /* get the current slot */
+    slot->end_us = loop->handle->get_time_us();                             /* set the end timestamp */
+    if (isd17xx_stop(loop->handle) != 0)                                    /* stop */
+    {
+        slot->state = ISD17XX_LOOP_SLOT_DIRTY;                              /* unknown content */
+        
+        return 1;                                                           /* return error */
+    }
+    if (isd17xx_read_record_point(loop->handle, &point) != 0)               /* read the final record point */
+    {
+        slot->state = ISD17XX_LOOP_SLOT_DIRTY;                              /* unknown content */
+        
+        return 1;                                                           /* return error */
+    }
+    if ((point <= slot->start_addr) || (point > slot->end_addr + 1))        /* check the point */
+    {
+        point = slot->start_addr + 1;                                       /* nothing useful recorded */
+    }
+    slot->used_addr = point - 1;                                            /* set the used address */
+    slot->state = ISD17XX_LOOP_SLOT_FULL;                                   /* holds audio */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     erase the oldest slots ahead of time
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] count slot number to prepare
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 loop is running
+ * @note      call it in idle windows, the oldest audio of those slots is dropped
+ */
+uint8_t isd17xx_loop_erase_ahead(isd17xx_loop_t *loop, uint8_t count)
+{
+    uint8_t i;
+    uint8_t index;
+    uint8_t res;
+    uint16_t command_delay;
+    
+    if ((loop == NULL) || (loop->handle == NULL))                        /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (loop->handle->inited != 1)                                       /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (loop->running != 0)                                              /* check the running */
+    {
+        loop->handle->debug_print("isd17xx: loop is running.\n");        /* loop is running */
+        
+        return 6;                                                        /* return error */
+    }
+    
+    if (count >= loop->slot_num)                                         /* keep the newest slot */
+    {
+        count = loop->slot_num - 1;                                      /* limit the count */
+    }
+    res = 0;                                                             /* init 0 */
+    command_delay = loop->handle->command_delay;                         /* save the command delay */
+    loop->handle->command_delay = 0;                                     /* poll instead of delay */
+    for (i = 1; i <= count; i++)                                         /* prepare the next slots */
+    {
+        index = (loop->current + i) % loop->slot_num;                    /* get the index */
+        if (loop->slot[index].state != ISD17XX_LOOP_SLOT_ERASED)         /* check the state */
+        {
+            if (a_isd17xx_loop_erase(loop, index) != 0)                  /* erase */
+            {
+                res = 1;                                                 /* set failed */
+                
+                break;                                                   /* break */
+            }
+        }
+    }
+    loop->handle->command_delay = command_delay;                         /* restore the command delay */
+    
+    return res;                                                          /* return the result */
+}
+
+/**
+ * @brief     play the newest audio
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] seconds newest seconds to play
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 seconds is 0
+ *            - 5 timeout
+ *            - 6 loop is running
+ *            - 7 no audio
+ * @note      the start row inside the oldest slot is estimated from its timestamps
+ */
+uint8_t isd17xx_loop_play_latest(isd17xx_loop_t *loop, uint32_t seconds, uint32_t timeout_ms)
+{
+    uint8_t i;
+    uint8_t index;
+    uint16_t len;
+    uint16_t num;
+    uint16_t rows;
+    uint64_t need;
+    uint64_t acc;
+    uint64_t dur;
+    isd17xx_loop_slot_t *slot;
+    isd17xx_phrase_range_t back[ISD17XX_LOOP_MAX_SLOT];
+    isd17xx_phrase_range_t range[ISD17XX_LOOP_MAX_SLOT];
+    
+    if ((loop == NULL) || (loop->handle == NULL))                                                    /* check handle */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (loop->handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                                    /* return error */
+    }
+    if (seconds == 0)                                                                                /* check the seconds */
+    {
+        loop->handle->debug_print("isd17xx: seconds is 0.\n");                                       /* seconds is 0 */
+        
+        return 4;                                                                                    /* return error */
+    }
+    if (loop->running != 0)                                                                          /* check the running */
+    {
+        loop->handle->debug_print("isd17xx: loop is running.\n");                                    /* loop is running */
+        
+        return 6;                                                                                    /* return error */
+    }
+    
+    need = (uint64_t)seconds * 1000000;                                                              /* get the needed time */
+    acc = 0;                                                                                         /* init 0 */
+    len = 0;                                                                                         /* init 0 */
+    for (i = 0; i < loop->slot_num; i++)                                                             /* walk from the newest slot */
+    {
+        index = (loop->current + loop->slot_num - i) % loop->slot_num;                               /* get the index */
+        slot = &loop->slot[index];                                                                   /* get the slot */
+        if ((slot->state != ISD17XX_LOOP_SLOT_FULL) || (slot->used_addr <= slot->start_addr))        /* check the audio */
+        {
+            break;                                                                                   /* older audio is not contiguous */
+        }
+        back[len].start_addr = slot->start_addr;                                                     /* set the start address */
+        back[len].end_addr = slot->used_addr;                                                        /* set the end address */
+        len++;                                                                                       /* len++ */
+        dur = slot->end_us - slot->start_us;                                                         /* get the slot time */
+        acc += dur;                                                                                  /* accumulate */
+        if (acc >= need)                                                                             /* check the needed time */
+        {
+            rows = slot->used_addr - slot->start_addr + 1;                                           /* get the rows */
+            rows = (uint16_t)((uint64_t)rows * (acc - need) / ((dur != 0) ? dur : 1));               /* get the skipped rows */
+            if (back[len - 1].start_addr + rows >= back[len - 1].end_addr)                           /* keep two rows at least */
+            {
+                rows = back[len - 1].end_addr - back[len - 1].start_addr - 1;                        /* limit the rows */
+            }
+            back[len - 1].start_addr += rows;                                                        /* skip the older part */
+            
+            break;                                                                                   /* break */
+        }
+    }
+    if (len == 0)                                                                                    /* check the length */
+    {
+        loop->handle->debug_print("isd17xx: no audio.\n");                                           /* no audio */
+        
+        return 7;                                                                                    /* return error */
+    }
+    
+    range[0] = back[len - 1];                                                                        /* the oldest range */
+    num = 1;                                                                                         /* merged length */
+    for (i = 1; i < len; i++)                                                                        /* chronological order */
+    {
+        if (range[num - 1].end_addr + 1 == back[len - 1 - i].start_addr)                             /* check the continuity */
+        {
+            range[num - 1].end_addr = back[len - 1 - i].end_addr;                                    /* merge */
+        }
+        else
+        {
+            range[num] = back[len - 1 - i];                                                          /* append */
+            num++;                                                                                   /* num++ */
+        }
+    }
+    
+    return isd17xx_phrase_play(loop->handle, range, num, timeout_ms);                                /* play back to back */
+}
+
+/**
+ * @brief      get the loop statistics
+ * @param[in]  *loop pointer to a loop structure
+ * @param[out] *rollover pointer to a rollover count buffer
+ * @param[out] *erase_miss pointer to an erase miss count buffer
+ * @param[out] *max_dead_us pointer to a max dead time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_loop_get_statistics(isd17xx_loop_t *loop, uint32_t *rollover, uint32_t *erase_miss, uint32_t *max_dead_us)
+{
+    if ((loop == NULL) || (loop->handle == NULL))        /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (loop->handle->inited != 1)                       /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *rollover = loop->rollover_count;                    /* get the rollover count */
+    *erase_miss = loop->erase_miss_count;                /* get the erase miss count */
+    *max_dead_us = loop->max_dead_us;                    /* get the max dead time */
+    
+    return 0;                                            /* success return 0 */
+}
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_loop.h
+ * @brief     driver isd17xx loop header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_LOOP_H
+#define DRIVER_ISD17XX_LOOP_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_loop_driver isd17xx loop driver function
+ * @brief    isd17xx loop driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx loop max definition
+ */
+#ifndef ISD17XX_LOOP_MAX_SLOT
+    #define ISD17XX_LOOP_MAX_SLOT        16          /**< max slot number */
+#endif
+#ifndef ISD17XX_LOOP_TIMEOUT
+    #define ISD17XX_LOOP_TIMEOUT         1000        /**< erase and record start timeout in ms */
+#endif
+
+/**
+ * @brief isd17xx loop slot state enumeration definition
+ */
+typedef enum
+{
+    ISD17XX_LOOP_SLOT_DIRTY     = 0x00,        /**< unknown content */
+    ISD17XX_LOOP_SLOT_ERASED    = 0x01,        /**< erased and ready to record */
+    ISD17XX_LOOP_SLOT_RECORDING = 0x02,        /**< recording */
+    ISD17XX_LOOP_SLOT_FULL      = 0x03,        /**< holds audio */
+} isd17xx_loop_slot_state_t;
+
+/**
+ * @brief isd17xx loop slot structure definition
+ */
+typedef struct isd17xx_loop_slot_s
+{
+    uint16_t start_addr;        /**< start address */
+    uint16_t end_addr;          /**< end address */
+    uint16_t used_addr;         /**< last recorded address */
+    uint8_t state;              /**< slot state */
+    uint64_t start_us;          /**< record start timestamp in us */
+    uint64_t end_us;            /**< record end timestamp in us */
+} isd17xx_loop_slot_t;
+
+/**
+ * @brief isd17xx loop structure definition
+ */
+typedef struct isd17xx_loop_s
+{
+    isd17xx_handle_t *handle;                               /**< isd17xx handle */
+    isd17xx_loop_slot_t slot[ISD17XX_LOOP_MAX_SLOT];        /**< slot catalog */
+    uint8_t slot_num;                                       /**< slot number */
+    uint8_t current;                                        /**< current slot */
+    uint8_t running;                                        /**< running flag */
+    uint32_t rollover_count;                                /**< rollover count */
+    uint32_t erase_miss_count;                              /**< rollover into a slot not erased ahead */
+    uint32_t last_dead_us;                                  /**< last rollover dead time in us */
+    uint32_t max_dead_us;                                   /**< max rollover dead time in us */
+} isd17xx_loop_t;
+
+/**
+ * @brief     initialize the loop recorder
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr region start address
+ * @param[in] end_addr region end address
+ * @param[in] slot_num slot number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_us is NULL
+ *            - 5 region or slot number is invalid
+ * @note      every slot needs at least two rows
+ */
+uint8_t isd17xx_loop_init(isd17xx_loop_t *loop, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr, uint8_t slot_num);
+
+/**
+ * @brief     start the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 loop is running
+ * @note      recording continues in the slot after the newest one
+ */
+uint8_t isd17xx_loop_start(isd17xx_loop_t *loop);
+
+/**
+ * @brief     poll the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it faster than one slot time, the end of a slot is detected
+ *            from the record bit and the next slot is started at once
+ */
+uint8_t isd17xx_loop_poll(isd17xx_loop_t *loop);
+
+/**
+ * @brief     stop the loop recording
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the current slot is cut at the final record point
+ */
+uint8_t isd17xx_loop_stop(isd17xx_loop_t *loop);
+
+/**
+ * @brief     erase the oldest slots ahead of time
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] count slot number to prepare
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 6 loop is running
+ * @note      call it in idle windows, the oldest audio of those slots is dropped
+ */
+uint8_t isd17xx_loop_erase_ahead(isd17xx_loop_t *loop, uint8_t count);
+
+/**
+ * @brief     play the newest audio
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] seconds newest seconds to play
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 seconds is 0
+ *            - 5 timeout
+ *            - 6 loop is running
+ *            - 7 no audio
+ * @note      the start row inside the oldest slot is estimated from its timestamps
+ */
+uint8_t isd17xx_loop_play_latest(isd17xx_loop_t *loop, uint32_t seconds, uint32_t timeout_ms);
+
+/**
+ * @brief      get the loop statistics
+ * @param[in]  *loop pointer to a loop structure
+ * @param[out] *rollover pointer to a rollover count buffer
+ * @param[out] *erase_miss pointer to an erase miss count buffer
+ * @param[out] *max_dead_us pointer to a max dead time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t isd17xx_loop_get_statistics(isd17xx_loop_t *loop, uint32_t *rollover, uint32_t *erase_miss, uint32_t *max_dead_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
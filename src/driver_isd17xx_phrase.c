@@ -0,0 +1,438 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_phrase.c
+ * @brief     driver isd17xx phrase source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_phrase.h"
+
+/**
+ * @brief number word table definition
+ */
+static const char *const gsc_ones[20] =
+{
+    "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
+    "ten", "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen",
+    "seventeen", "eighteen", "nineteen",
+};
+static const char *const gsc_tens[10] =
+{
+    "", "", "twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty", "ninety",
+};
+
+/**
+ * @brief         append a word
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in]     *catalog pointer to a segment catalog
+ * @param[in]     catalog_len catalog length
+ * @param[in]     *word pointer to a lower case word
+ * @param[out]    *range pointer to a range buffer
+ * @param[in]     max range buffer length
+ * @param[in,out] *num pointer to a used range number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 word is not in the catalog
+ *                - 4 range buffer is full
+ * @note          none
+ */
+static uint8_t a_isd17xx_phrase_append(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                                       const char *word, isd17xx_phrase_range_t *range, uint16_t max, uint16_t *num)
+{
+    uint16_t i;
+    
+    for (i = 0; i < catalog_len; i++)                                                /* loop all segments */
+    {
+        if (strcmp(catalog[i].word, word) == 0)                                      /* check the word */
+        {
+            break;                                                                   /* break */
+        }
+    }
+    if (i == catalog_len)                                                            /* check the result */
+    {
+        handle->debug_print("isd17xx: %s is not in the catalog.\n", word);           /* word is not in the catalog */
+        
+        return 1;                                                                    /* return error */
+    }
+    
+    if ((*num != 0) &&
+        (range[*num - 1].end_addr + 1 == catalog[i].start_addr))                     /* check contiguous */
+    {
+        range[*num - 1].end_addr = catalog[i].end_addr;                              /* merge the range */
+        
+        return 0;                                                                    /* success return 0 */
+    }
+    if (*num >= max)                                                                 /* check the buffer */
+    {
+        handle->debug_print("isd17xx: range buffer is full.\n");                     /* range buffer is full */
+        
+        return 4;                                                                    /* return error */
+    }
+    range[*num].start_addr = catalog[i].start_addr;                                  /* set the start address */
+    range[*num].end_addr = catalog[i].end_addr;                                      /* set the end address */
+    (*num)++;                                                                        /* num++ */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief         append a number
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in]     *catalog pointer to a segment catalog
+ * @param[in]     catalog_len catalog length
+ * @param[in]     number input number
+ * @param[out]    *range pointer to a range buffer
+ * @param[in]     max range buffer length
+ * @param[in,out] *num pointer to a used range number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 word is not in the catalog
+ *                - 4 range buffer is full
+ * @note          number <= 9999
+ */
+static uint8_t a_isd17xx_phrase_append_number(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                                              uint16_t number, isd17xx_phrase_range_t *range, uint16_t max, uint16_t *num)
+{
+    uint8_t res;
+    const char *word[8];
+    uint8_t cnt;
+    uint8_t i;
+    
+    cnt = 0;                                                                          /* init 0 */
+    if (number >= 1000)                                                               /* check thousand */
+    {
+        word[cnt++] = gsc_ones[number / 1000];                                        /* set the thousand digit */
+        word[cnt++] = "thousand";                                                     /* set thousand */
+        number %= 1000;                                                               /* get the remainder */
+    }
+    if (number >= 100)                                                                /* check hundred */
+    {
+        word[cnt++] = gsc_ones[number / 100];                                         /* set the hundred digit */
+        word[cnt++] = "hundred";                                                      /* set hundred */
+        number %= 100;                                                                /* get the remainder */
+    }
+    if (number >= 20)                                                                 /* check tens */
+    {
+        word[cnt++] = gsc_tens[number / 10];                                          /* set the tens */
+        number %= 10;                                                                 /* get the remainder */
+        if (number != 0)                                                              /* check ones */
+        {
+            word[cnt++] = gsc_ones[number];                                           /* set the ones */
+        }
+    }
+    else if ((number != 0) || (cnt == 0))                                             /* check the ones and zero */
+    {
+        word[cnt++] = gsc_ones[number];                                               /* set the ones */
+    }
+    else
+    {
+        /* nothing to do */
+    }
+    
+    for (i = 0; i < cnt; i++)                                                         /* loop all words */
+    {
+        res = a_isd17xx_phrase_append(handle, catalog, catalog_len,
+                                      word[i], range, max, num);                      /* append the word */
+        if (res != 0)                                                                 /* check the result */
+        {
+            return res;                                                               /* return error */
+        }
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     wait the status bit
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] mask status2 mask
+ * @param[in] level wait level
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 get status failed
+ *            - 5 timeout
+ * @note      none
+ */
+static uint8_t a_isd17xx_phrase_wait(isd17xx_handle_t *handle, uint8_t mask, uint8_t level, uint32_t timeout_ms)
+{
+    uint8_t status2;
+    uint16_t status1;
+    uint64_t next;
+    uint64_t deadline;
+    
+    (void)isd17xx_get_clock(handle, &next);                                           /* poll from now */
+    deadline = next + (uint64_t)timeout_ms * 1000;                                    /* set the deadline */
+    while (1)                                                                         /* loop */
+    {
+        if (isd17xx_get_status(handle, &status1, &status2) != 0)                      /* get the status */
+        {
+            return 1;                                                                 /* return error */
+        }
+        if ((((status2 & mask) != 0) ? 1 : 0) == level)                               /* check the level */
+        {
+            return 0;                                                                 /* success return 0 */
+        }
+        if (next >= deadline)                                                         /* check the timeout */
+        {
+            handle->debug_print("isd17xx: timeout.\n");                               /* timeout */
+            
+            return 5;                                                                 /* return error */
+        }
+        next += 1000;                                                                 /* next poll in 1ms */
+        (void)isd17xx_delay_until(handle, next);                                      /* delay until the next poll */
+    }
+}
+
+/**
+ * @brief         compose a phrase into play ranges
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in]     *catalog pointer to a segment catalog
+ * @param[in]     catalog_len catalog length
+ * @param[in]     *text pointer to a phrase text
+ * @param[out]    *range pointer to a range buffer
+ * @param[in,out] *len pointer to a range length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 word is not in the catalog
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 range buffer is full
+ *                - 5 number is over 9999
+ *                - 6 word is too long
+ * @note          numbers are expanded to english words, e.g. 35 is "thirty five"
+ *                contiguous segments are merged into one range
+ */
+uint8_t isd17xx_phrase_compose(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                               const char *text, isd17xx_phrase_range_t *range, uint16_t *len)
+{
+    uint8_t res;
+    uint8_t digit;
+    uint16_t max;
+    uint16_t num;
+    uint16_t l;
+    uint32_t number;
+    char word[ISD17XX_PHRASE_MAX_WORD + 1];
+    
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    
+    max = *len;                                                                       /* save the max length */
+    num = 0;                                                                          /* init 0 */
+    while (*text != '\0')                                                             /* loop all text */
+    {
+        if ((*text == ' ') || (*text == '\t') || (*text == ',') || (*text == '.'))    /* check the separator */
+        {
+            text++;                                                                   /* skip the separator */
+            
+            continue;                                                                 /* continue */
+        }
+        
+        l = 0;                                                                        /* init 0 */
+        digit = 1;                                                                    /* init 1 */
+        while ((*text != '\0') && (*text != ' ') && (*text != '\t') &&
+               (*text != ',') && (*text != '.'))                                      /* copy the token */
+        {
+            if (l >= ISD17XX_PHRASE_MAX_WORD)                                         /* check the length */
+            {
+                handle->debug_print("isd17xx: word is too long.\n");                  /* word is too long */
+                
+                return 6;                                                             /* return error */
+            }
+            if ((*text < '0') || (*text > '9'))                                       /* check the digit */
+            {
+                digit = 0;                                                            /* not a number */
+            }
+            if ((*text >= 'A') && (*text <= 'Z'))                                     /* check upper case */
+            {
+                word[l] = (char)(*text - 'A' + 'a');                                  /* to lower case */
+            }
+            else
+            {
+                word[l] = *text;                                                      /* copy the char */
+            }
+            l++;                                                                      /* l++ */
+            text++;                                                                   /* next char */
+        }
+        word[l] = '\0';                                                               /* set the end */
+        
+        if (digit != 0)                                                               /* number token */
+        {
+            number = 0;                                                               /* init 0 */
+            for (l = 0; word[l] != '\0'; l++)                                         /* loop all digits */
+            {
+                number = number * 10 + (uint32_t)(word[l] - '0');                     /* get the number */
+                if (number > 9999)                                                    /* check the number */
+                {
+                    handle->debug_print("isd17xx: number is over 9999.\n");           /* number is over 9999 */
+                    
+                    return 5;                                                         /* return error */
+                }
+            }
+            res = a_isd17xx_phrase_append_number(handle, catalog, catalog_len,
+                                                 (uint16_t)number, range, max, &num); /* append the number */
+        }
+        else                                                                          /* word token */
+        {
+            res = a_isd17xx_phrase_append(handle, catalog, catalog_len,
+                                          word, range, max, &num);                    /* append the word */
+        }
+        if (res != 0)                                                                 /* check the result */
+        {
+            return res;                                                               /* return error */
+        }
+    }
+    *len = num;                                                                       /* set the range length */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     play ranges back to back
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *range pointer to a range buffer
+ * @param[in] len range length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is 0
+ *            - 5 timeout
+ * @note      every range costs one set play command, the next one is queued
+ *            as soon as the chip is ready so no silence is inserted
+ */
+uint8_t isd17xx_phrase_play(isd17xx_handle_t *handle, const isd17xx_phrase_range_t *range, uint16_t len, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint16_t i;
+    uint16_t command_delay;
+    
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if (len == 0)                                                                     /* check the length */
+    {
+        handle->debug_print("isd17xx: len is 0.\n");                                  /* len is 0 */
+        
+        return 4;                                                                     /* return error */
+    }
+    
+    command_delay = handle->command_delay;                                            /* save the command delay */
+    handle->command_delay = 0;                                                        /* poll instead of delay */
+    res = 0;                                                                          /* init 0 */
+    for (i = 0; i < len; i++)                                                         /* loop all ranges */
+    {
+        if (i != 0)                                                                   /* queue the next range */
+        {
+            res = a_isd17xx_phrase_wait(handle, ISD17XX_STATUS2_RDY, 1, timeout_ms);  /* wait ready */
+            if (res != 0)                                                             /* check the result */
+            {
+                break;                                                                /* break */
+            }
+        }
+        if (isd17xx_set_play(handle, range[i].start_addr, range[i].end_addr) != 0)    /* set play */
+        {
+            res = 1;                                                                  /* set failed */
+            
+            break;                                                                    /* break */
+        }
+    }
+    if (res == 0)                                                                     /* check the result */
+    {
+        res = a_isd17xx_phrase_wait(handle, ISD17XX_STATUS2_PLAY, 0, timeout_ms);     /* wait the playback end */
+    }
+    handle->command_delay = command_delay;                                            /* restore the command delay */
+    
+    return res;                                                                       /* return the result */
+}
+
+/**
+ * @brief     compose and play a phrase
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *catalog pointer to a segment catalog
+ * @param[in] catalog_len catalog length
+ * @param[in] *text pointer to a phrase text
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 say failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_phrase_say(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                           const char *text, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint16_t len;
+    isd17xx_phrase_range_t range[ISD17XX_PHRASE_MAX_RANGE];
+    
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    
+    len = ISD17XX_PHRASE_MAX_RANGE;                                                   /* set the max length */
+    res = isd17xx_phrase_compose(handle, catalog, catalog_len, text, range, &len);    /* compose */
+    if (res != 0)                                                                     /* check the result */
+    {
+        return 1;                                                                     /* return error */
+    }
+    if (len == 0)                                                                     /* check the length */
+    {
+        return 0;                                                                     /* nothing to play */
+    }
+    res = isd17xx_phrase_play(handle, range, len, timeout_ms);                        /* play */
+    if (res != 0)                                                                     /* check the result */
+    {
+        return 1;                                                                     /* return error */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_phrase.h
+ * @brief     driver isd17xx phrase header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_PHRASE_H
+#define DRIVER_ISD17XX_PHRASE_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_phrase_driver isd17xx phrase driver function
+ * @brief    isd17xx phrase driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx phrase max definition
+ */
+#ifndef ISD17XX_PHRASE_MAX_RANGE
+    #define ISD17XX_PHRASE_MAX_RANGE        32        /**< max merged range in one phrase */
+#endif
+#ifndef ISD17XX_PHRASE_MAX_WORD
+    #define ISD17XX_PHRASE_MAX_WORD         32        /**< max word length */
+#endif
+
+/**
+ * @brief isd17xx phrase segment structure definition
+ */
+typedef struct isd17xx_phrase_segment_s
+{
+    const char *word;          /**< lower case word */
+    uint16_t start_addr;       /**< start address */
+    uint16_t end_addr;         /**< end address */
+} isd17xx_phrase_segment_t;
+
+/**
+ * @brief isd17xx phrase range structure definition
+ */
+typedef struct isd17xx_phrase_range_s
+{
+    uint16_t start_addr;       /**< start address */
+    uint16_t end_addr;         /**< end address */
+} isd17xx_phrase_range_t;
+
+/**
+ * @brief         compose a phrase into play ranges
+ * @param[in]     *handle pointer to an isd17xx handle structure
+ * @param[in]     *catalog pointer to a segment catalog
+ * @param[in]     catalog_len catalog length
+ * @param[in]     *text pointer to a phrase text
+ * @param[out]    *range pointer to a range buffer
+ * @param[in,out] *len pointer to a range length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 word is not in the catalog
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 range buffer is full
+ *                - 5 number is over 9999
+ *                - 6 word is too long
+ * @note          numbers are expanded to english words, e.g. 35 is "thirty five"
+ *                contiguous segments are merged into one range
+ */
+uint8_t isd17xx_phrase_compose(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                               const char *text, isd17xx_phrase_range_t *range, uint16_t *len);
+
+/**
+ * @brief     play ranges back to back
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *range pointer to a range buffer
+ * @param[in] len range length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len is 0
+ *            - 5 timeout
+ * @note      every range costs one set play command, the next one is queued
+ *            as soon as the chip is ready so no silence is inserted
+ */
+uint8_t isd17xx_phrase_play(isd17xx_handle_t *handle, const isd17xx_phrase_range_t *range, uint16_t len, uint32_t timeout_ms);
+
+/**
+ * @brief     compose and play a phrase
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *catalog pointer to a segment catalog
+ * @param[in] catalog_len catalog length
+ * @param[in] *text pointer to a phrase text
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 say failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_phrase_say(isd17xx_handle_t *handle, const isd17xx_phrase_segment_t *catalog, uint16_t catalog_len,
+                           const char *text, uint32_t timeout_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
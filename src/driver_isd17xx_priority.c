@@ -0,0 +1,437 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_priority.c
+ * @brief     driver isd17xx priority source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_priority.h"
+
+/**
+ * @brief     wait the play bit
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] level wanted level
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      polls with raw status frames, so no driver delay is added
+ */
+static uint8_t a_isd17xx_priority_wait(isd17xx_handle_t *handle, uint8_t level)
+{
+    uint8_t status2;
+    uint16_t status1;
+    uint64_t next;
+    uint64_t deadline;
+    
+    (void)isd17xx_get_clock(handle, &next);                                       /* poll from now */
+    deadline = next + (uint64_t)ISD17XX_PRIORITY_START_TIMEOUT * 1000;            /* set the deadline */
+    while (1)                                                                     /* loop */
+    {
+        if (isd17xx_get_status(handle, &status1, &status2) != 0)                  /* get the status */
+        {
+            return 1;                                                             /* return error */
+        }
+        if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)                             /* check the command error */
+        {
+            handle->debug_print("isd17xx: command error.\n");                     /* command error */
+            
+            return 1;                                                             /* return error */
+        }
+        if ((((status2 & ISD17XX_STATUS2_PLAY) != 0) ? 1 : 0) == level)           /* check the play bit */
+        {
+            return 0;                                                             /* success return 0 */
+        }
+        if (next >= deadline)                                                     /* check the timeout */
+        {
+            handle->debug_print("isd17xx: play bit timeout.\n");                  /* play bit timeout */
+            
+            return 1;                                                             /* return error */
+        }
+        next += 1000;                                                             /* next poll in 1ms */
+        (void)isd17xx_delay_until(handle, next);                                  /* delay until the next poll */
+    }
+}
+
+/**
+ * @brief     start a clip and wait until it plays
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the set play frame is sent raw, without the command delay
+ */
+static uint8_t a_isd17xx_priority_start(isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+{
+    uint8_t buf[6];
+    uint8_t tx[7];
+    uint8_t rx[7];
+    isd17xx_spi_segment_t seg;
+    
+    buf[0] = 0x00;                                                                /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                   /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                            /* set start address */
+    buf[3] = end_addr & 0xFF;                                                     /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                              /* set end address */
+    buf[5] = 0x00;                                                                /* set 0x00 */
+    (void)isd17xx_frame_encode(ISD17XX_COMMAND_SET_PLAY, buf, 6, tx);             /* encode the frame */
+    seg.tx = tx;                                                                  /* set the tx */
+    seg.rx = rx;                                                                  /* set the rx */
+    seg.len = 7;                                                                  /* set 7 */
+    if (isd17xx_frame_transmit(handle, &seg, 1) != 0)                             /* set play */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return a_isd17xx_priority_wait(handle, 1);                                    /* wait until it plays */
+}
+
+/**
+ * @brief      capture the play point and stop
+ * @param[in]  *handle pointer to an isd17xx handle structure
+ * @param[out] *point pointer to a play point buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 stop failed
+ * @note       the point read and the stop share one transport call when spi_transmit_vector is linked
+ */
+static uint8_t a_isd17xx_priority_stop(isd17xx_handle_t *handle, uint16_t *point)
+{
+    uint8_t zero[3];
+    uint8_t point_tx[4];
+    uint8_t point_rx[4];
+    uint8_t stop_tx[2];
+    uint8_t stop_rx[2];
+    isd17xx_spi_segment_t seg[2];
+    
+    zero[0] = 0x00;                                                               /* set 0x00 */
+    zero[1] = 0x00;                                                               /* set 0x00 */
+    zero[2] = 0x00;                                                               /* set 0x00 */
+    (void)isd17xx_frame_encode(ISD17XX_COMMAND_RD_PLAY_PTR, zero, 3, point_tx);   /* set read play point command */
+    (void)isd17xx_frame_encode(ISD17XX_COMMAND_STOP, zero, 1, stop_tx);           /* set stop command */
+    seg[0].tx = point_tx;                                                         /* set the point tx */
+    seg[0].rx = point_rx;                                                         /* set the point rx */
+    seg[0].len = 4;                                                               /* set 4 */
+    seg[1].tx = stop_tx;                                                          /* set the stop tx */
+    seg[1].rx = stop_rx;                                                          /* set the stop rx */
+    seg[1].len = 2;                                                               /* set 2 */
+    if (isd17xx_frame_transmit(handle, seg, 2) != 0)                              /* read the point and stop */
+    {
+        return 1;                                                                 /* return error */
+    }
+    (void)isd17xx_frame_decode(point_rx, 4);                                      /* lsb to msb */
+    *point = (uint16_t)(point_rx[3] & 0x7) << 8 | point_rx[2];                    /* set the point */
+    
+    return a_isd17xx_priority_wait(handle, 0);                                    /* wait until it stops */
+}
+
+/**
+ * @brief     update the playback state
+ * @param[in] *priority pointer to a priority structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ * @note      when the current clip has ended, the last preempted clip is resumed
+ */
+static uint8_t a_isd17xx_priority_update(isd17xx_priority_t *priority)
+{
+    uint8_t status2;
+    uint16_t status1;
+    isd17xx_priority_clip_t *clip;
+    
+    if (priority->current.level == 0)                                                                 /* check the idle */
+    {
+        return 0;                                                                                     /* success return 0 */
+    }
+    if (isd17xx_get_status(priority->handle, &status1, &status2) != 0)                                /* get the status */
+    {
+        return 1;                                                                                     /* return error */
+    }
+    if ((status2 & ISD17XX_STATUS2_PLAY) != 0)                                                        /* check the play bit */
+    {
+        return 0;                                                                                     /* still playing */
+    }
+    
+    priority->current.level = 0;                                                                      /* current clip ended */
+    while (priority->depth != 0)                                                                      /* resume the preempted clips */
+    {
+        priority->depth--;                                                                            /* pop */
+        clip = &priority->saved[priority->depth];                                                     /* get the clip */
+        if (clip->start_addr >= clip->end_addr)                                                       /* check the left part */
+        {
+            continue;                                                                                 /* nothing left */
+        }
+        if (a_isd17xx_priority_start(priority->handle, clip->start_addr, clip->end_addr) != 0)        /* resume */
+        {
+            return 1;                                                                                 /* return error */
+        }
+        priority->current = *clip;                                                                    /* set the current */
+        
+        break;                                                                                        /* break */
+    }
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     initialize the priority arbiter
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] latency_target_us preemption latency target in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_us is NULL
+ * @note      get_time_us must be linked to measure the preemption latency
+ */
+uint8_t isd17xx_priority_init(isd17xx_priority_t *priority, isd17xx_handle_t *handle, uint32_t latency_target_us)
+{
+    if ((priority == NULL) || (handle == NULL))                        /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    if (handle->get_time_us == NULL)                                   /* check get_time_us */
+    {
+        handle->debug_print("isd17xx: get_time_us is null.\n");        /* get_time_us is null */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    memset(priority, 0, sizeof(isd17xx_priority_t));                   /* clear the priority */
+    priority->handle = handle;                                         /* set the handle */
+    priority->latency_target_us = latency_target_us;                   /* set the latency target */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the preemption latency target
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] latency_target_us preemption latency target in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 disables the check
+ */
+uint8_t isd17xx_priority_set_latency_target(isd17xx_priority_t *priority, uint32_t latency_target_us)
+{
+    if ((priority == NULL) || (priority->handle == NULL))        /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (priority->handle->inited != 1)                           /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    
+    priority->latency_target_us = latency_target_us;             /* set the latency target */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     play a clip at a priority level
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] level priority level
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 level is 0 or address is invalid
+ *            - 5 latency target is exceeded
+ *            - 6 a clip with the same or a higher level is playing
+ *            - 7 preempted clip depth is full
+ * @note      a lower level clip is stopped, its play point is saved and it is
+ *            resumed by isd17xx_priority_poll when the urgent clip ends
+ *            when 5 is returned the urgent clip is playing but was late
+ */
+uint8_t isd17xx_priority_play(isd17xx_priority_t *priority, uint8_t level, uint16_t start_addr, uint16_t end_addr)
+{
+    uint16_t point;
+    uint64_t t0;
+    uint64_t latency;
+    isd17xx_handle_t *handle;
+    
+    if ((priority == NULL) || (priority->handle == NULL))                                                       /* check handle */
+    {
+        return 2;                                                                                               /* return error */
+    }
+    handle = priority->handle;                                                                                  /* get the handle */
+    if (handle->inited != 1)                                                                                    /* check handle initialization */
+    {
+        return 3;                                                                                               /* return error */
+    }
+    if ((level == 0) || (start_addr >= end_addr) || (end_addr > handle->end_address))                           /* check the param */
+    {
+        handle->debug_print("isd17xx: level or address is invalid.\n");                                         /* level or address is invalid */
+        
+        return 4;                                                                                               /* return error */
+    }
+    if (a_isd17xx_priority_update(priority) != 0)                                                               /* update the state */
+    {
+        return 1;                                                                                               /* return error */
+    }
+    
+    if (priority->current.level == 0)                                                                           /* idle */
+    {
+        if (a_isd17xx_priority_start(handle, start_addr, end_addr) != 0)                                        /* start */
+        {
+            return 1;                                                                                           /* return error */
+        }
+        priority->current.start_addr = start_addr;                                                              /* set the start address */
+        priority->current.end_addr = end_addr;                                                                  /* set the end address */
+        priority->current.level = level;                                                                        /* set the level */
+        
+        return 0;                                                                                               /* success return 0 */
+    }
+    if (level <= priority->current.level)                                                                       /* check the level */
+    {
+        handle->debug_print("isd17xx: busy.\n");                                                                /* busy */
+        
+        return 6;                                                                                               /* return error */
+    }
+    if (priority->depth >= ISD17XX_PRIORITY_MAX_DEPTH)                                                          /* check the depth */
+    {
+        handle->debug_print("isd17xx: depth is full.\n");                                                       /* depth is full */
+        
+        return 7;                                                                                               /* return error */
+    }
+    
+    t0 = handle->get_time_us();                                                                                 /* get the stop time */
+    if (a_isd17xx_priority_stop(handle, &point) != 0)                                                           /* capture the position and stop */
+    {
+        return 1;                                                                                               /* return error */
+    }
+    if (point < priority->current.start_addr)                                                                   /* check the point */
+    {
+        point = priority->current.start_addr;                                                                   /* clamp to the start */
+    }
+    priority->saved[priority->depth].start_addr = point;                                                        /* resume from the saved row */
+    priority->saved[priority->depth].end_addr = priority->current.end_addr;                                     /* set the end address */
+    priority->saved[priority->depth].level = priority->current.level;                                           /* set the level */
+    priority->depth++;                                                                                          /* push */
+    priority->current.level = 0;                                                                                /* stopped */
+    if (a_isd17xx_priority_start(handle, start_addr, end_addr) != 0)                                            /* start the urgent clip */
+    {
+        return 1;                                                                                               /* return error */
+    }
+    latency = handle->get_time_us() - t0;                                                                       /* get the latency */
+    priority->current.start_addr = start_addr;                                                                  /* set the start address */
+    priority->current.end_addr = end_addr;                                                                      /* set the end address */
+    priority->current.level = level;                                                                            /* set the level */
+    priority->last_latency_us = (latency > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)latency;                      /* set the last latency */
+    if (priority->last_latency_us > priority->max_latency_us)                                                   /* check the max latency */
+    {
+        priority->max_latency_us = priority->last_latency_us;                                                   /* set the max latency */
+    }
+    priority->preempt_count++;                                                                                  /* preempt count++ */
+    if ((priority->latency_target_us != 0) && (priority->last_latency_us > priority->latency_target_us))        /* check the target */
+    {
+        priority->overrun_count++;                                                                              /* overrun count++ */
+        handle->debug_print("isd17xx: preemption took %u us.\n", (unsigned int)priority->last_latency_us);      /* preemption is late */
+        
+        return 5;                                                                                               /* return error */
+    }
+    
+    return 0;                                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      poll the playback and resume the preempted clip
+ * @param[in]  *priority pointer to a priority structure
+ * @param[out] *level pointer to a current level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       level 0 means idle
+ */
+uint8_t isd17xx_priority_poll(isd17xx_priority_t *priority, uint8_t *level)
+{
+    if ((priority == NULL) || (priority->handle == NULL))        /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (priority->handle->inited != 1)                           /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    
+    if (a_isd17xx_priority_update(priority) != 0)                /* update the state */
+    {
+        return 1;                                                /* return error */
+    }
+    *level = priority->current.level;                            /* get the level */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the preemption latency
+ * @param[in]  *priority pointer to a priority structure
+ * @param[out] *last_us pointer to a last latency buffer
+ * @param[out] *max_us pointer to a max latency buffer
+ * @param[out] *overrun pointer to an overrun count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       latency is measured from the stop command to the urgent playback start
+ */
+uint8_t isd17xx_priority_get_latency(isd17xx_priority_t *priority, uint32_t *last_us, uint32_t *max_us, uint32_t *overrun)
+{
+    if ((priority == NULL) || (priority->handle == NULL))        /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (priority->handle->inited != 1)                           /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    
+    *last_us = priority->last_latency_us;                        /* get the last latency */
+    *max_us = priority->max_latency_us;                          /* get the max latency */
+    *overrun = priority->overrun_count;                          /* get the overrun count */
+    
+    return 0;                                                    /* success return 0 */
+}
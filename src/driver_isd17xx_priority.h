@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_priority.h
+ * @brief     driver isd17xx priority header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_PRIORITY_H
+#define DRIVER_ISD17XX_PRIORITY_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_priority_driver isd17xx priority driver function
+ * @brief    isd17xx priority driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx priority max definition
+ */
+#ifndef ISD17XX_PRIORITY_MAX_DEPTH
+    #define ISD17XX_PRIORITY_MAX_DEPTH        4          /**< max preempted clip depth */
+#endif
+#ifndef ISD17XX_PRIORITY_START_TIMEOUT
+    #define ISD17XX_PRIORITY_START_TIMEOUT    100        /**< playback start timeout in ms */
+#endif
+
+/**
+ * @brief isd17xx priority clip structure definition
+ */
+typedef struct isd17xx_priority_clip_s
+{
+    uint16_t start_addr;       /**< start address */
+    uint16_t end_addr;         /**< end address */
+    uint8_t level;             /**< priority level, 0 means idle */
+} isd17xx_priority_clip_t;
+
+/**
+ * @brief isd17xx priority structure definition
+ */
+typedef struct isd17xx_priority_s
+{
+    isd17xx_handle_t *handle;                                        /**< isd17xx handle */
+    isd17xx_priority_clip_t current;                                 /**< current clip */
+    isd17xx_priority_clip_t saved[ISD17XX_PRIORITY_MAX_DEPTH];       /**< preempted clips */
+    uint8_t depth;                                                   /**< preempted clip depth */
+    uint32_t latency_target_us;                                      /**< preemption latency target in us */
+    uint32_t last_latency_us;                                        /**< last preemption latency in us */
+    uint32_t max_latency_us;                                         /**< max preemption latency in us */
+    uint32_t preempt_count;                                          /**< preemption count */
+    uint32_t overrun_count;                                          /**< latency target overrun count */
+} isd17xx_priority_t;
+
+/**
+ * @brief     initialize the priority arbiter
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] latency_target_us preemption latency target in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_us is NULL
+ * @note      get_time_us must be linked to measure the preemption latency
+ */
+uint8_t isd17xx_priority_init(isd17xx_priority_t *priority, isd17xx_handle_t *handle, uint32_t latency_target_us);
+
+/**
+ * @brief     set the preemption latency target
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] latency_target_us preemption latency target in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 disables the check
+ */
+uint8_t isd17xx_priority_set_latency_target(isd17xx_priority_t *priority, uint32_t latency_target_us);
+
+/**
+ * @brief     play a clip at a priority level
+ * @param[in] *priority pointer to a priority structure
+ * @param[in] level priority level
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 level is 0 or address is invalid
+ *            - 5 latency target is exceeded
+ *            - 6 a clip with the same or a higher level is playing
+ *            - 7 preempted clip depth is full
+ * @note      a lower level clip is stopped, its play point is saved and it is
+ *            resumed by isd17xx_priority_poll when the urgent clip ends
+ *            when 5 is returned the urgent clip is playing but was late
+ */
+uint8_t isd17xx_priority_play(isd17xx_priority_t *priority, uint8_t level, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief      poll the playback and resume the preempted clip
+ * @param[in]  *priority pointer to a priority structure
+ * @param[out] *level pointer to a current level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       level 0 means idle
+ */
+uint8_t isd17xx_priority_poll(isd17xx_priority_t *priority, uint8_t *level);
+
+/**
+ * @brief      get the preemption latency
+ * @param[in]  *priority pointer to a priority structure
+ * @param[out] *last_us pointer to a last latency buffer
+ * @param[out] *max_us pointer to a max latency buffer
+ * @param[out] *overrun pointer to an overrun count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       latency is measured from the stop command to the urgent playback start
+ */
+uint8_t isd17xx_priority_get_latency(isd17xx_priority_t *priority, uint32_t *last_us, uint32_t *max_us, uint32_t *overrun);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_safe.c
+ * @brief     driver isd17xx safe source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_safe.h"
+
+/**
+ * @brief     publish a status snapshot
+ * @param[in] *safe pointer to a safe structure
+ * @param[in] status1 status1
+ * @param[in] status2 status2
+ * @note      writers are serialized by the handle lock
+ */
+static void a_isd17xx_safe_publish(isd17xx_safe_t *safe, uint16_t status1, uint8_t status2)
+{
+    safe->seq++;                                                                                  /* odd, writing */
+    ISD17XX_SAFE_BARRIER();                                                                       /* order the sequence before the data */
+    safe->status1 = status1;                                                                      /* set status1 */
+    safe->status2 = status2;                                                                      /* set status2 */
+    safe->time_us = (safe->handle->get_time_us != NULL) ? safe->handle->get_time_us() : 0;        /* set the time */
+    ISD17XX_SAFE_BARRIER();                                                                       /* order the data before the sequence */
+    safe->seq++;                                                                                  /* even, done */
+}
+
+/**
+ * @brief     initialize the safe layer
+ * @param[in] *safe pointer to a safe structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *lock pointer to a lock function address
+ * @param[in] *unlock pointer to an unlock function address
+ * @param[in] *arg pointer to a lock argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 lock or unlock is NULL
+ * @note      the lock must be recursive when locked sequences call other
+ *            locked functions of this module, e.g. a pthread recursive mutex
+ */
+uint8_t isd17xx_safe_init(isd17xx_safe_t *safe, isd17xx_handle_t *handle,
+                          void (*lock)(void *arg), void (*unlock)(void *arg), void *arg)
+{
+    if ((safe == NULL) || (handle == NULL))                               /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if ((lock == NULL) || (unlock == NULL))                               /* check the lock */
+    {
+        handle->debug_print("isd17xx: lock or unlock is null.\n");        /* lock or unlock is null */
+        
+        return 4;                                                         /* return error */
+    }
+    
+    memset(safe, 0, sizeof(isd17xx_safe_t));                              /* clear the safe */
+    safe->handle = handle;                                                /* set the handle */
+    safe->lock = lock;                                                    /* set the lock */
+    safe->unlock = unlock;                                                /* set the unlock */
+    safe->arg = arg;                                                      /* set the argument */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     lock the handle
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      hold it around every multi-frame operation, e.g. the apc read
+ *            modify write of isd17xx_set_volume
+ */
+uint8_t isd17xx_safe_lock(isd17xx_safe_t *safe)
+{
+    if ((safe == NULL) || (safe->lock == NULL))                 /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    
+    safe->lock(safe->arg);                                      /* lock */
+    if (safe->depth == 0)                                       /* outer lock */
+    {
+        safe->frame_count = safe->handle->frame_count;          /* mark the frame count */
+    }
+    safe->depth++;                                              /* nest */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     unlock the handle
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      when the outer lock sent spi frames the status is read and published
+ *            before the lock is released, so the snapshot always shows the effect
+ *            of the last command, an idle lock sends nothing
+ */
+uint8_t isd17xx_safe_unlock(isd17xx_safe_t *safe)
+{
+    uint8_t status2;
+    uint16_t status1;
+    
+    if ((safe == NULL) || (safe->unlock == NULL))                              /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    if (safe->depth != 0)                                                      /* check the depth */
+    {
+        safe->depth--;                                                         /* unnest */
+    }
+    if ((safe->depth == 0) && (safe->handle->inited == 1) &&
+        (safe->handle->frame_count != safe->frame_count) &&                    /* a command was sent */
+        (isd17xx_get_status(safe->handle, &status1, &status2) == 0))           /* get the status */
+    {
+        a_isd17xx_safe_publish(safe, status1, status2);                        /* publish */
+    }
+    safe->unlock(safe->arg);                                                   /* unlock */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     read the status and publish the snapshot
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the caller may already hold the lock
+ */
+uint8_t isd17xx_safe_refresh(isd17xx_safe_t *safe)
+{
+    uint8_t res;
+    uint8_t status2;
+    uint16_t status1;
+    
+    if ((safe == NULL) || (safe->handle == NULL))                      /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (safe->handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    safe->lock(safe->arg);                                             /* lock */
+    res = isd17xx_get_status(safe->handle, &status1, &status2);        /* get the status */
+    if (res == 0)                                                      /* check the result */
+    {
+        a_isd17xx_safe_publish(safe, status1, status2);                /* publish */
+    }
+    safe->unlock(safe->arg);                                           /* unlock */
+    
+    return (res != 0) ? 1 : 0;                                         /* return the result */
+}
+
+/**
+ * @brief     run the irq handler and publish the snapshot
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_safe_irq_handler(isd17xx_safe_t *safe)
+{
+    uint8_t res;
+    uint8_t status2;
+    uint16_t status1;
+    
+    if ((safe == NULL) || (safe->handle == NULL))                                         /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (safe->handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    safe->lock(safe->arg);                                                                /* lock */
+    res = isd17xx_irq_handler(safe->handle);                                              /* run the irq handler */
+    if ((res == 0) && (isd17xx_get_status(safe->handle, &status1, &status2) == 0))        /* get the status */
+    {
+        a_isd17xx_safe_publish(safe, status1, status2);                                   /* publish */
+    }
+    safe->unlock(safe->arg);                                                              /* unlock */
+    
+    return (res != 0) ? 1 : 0;                                                            /* return the result */
+}
+
+/**
+ * @brief      read the status snapshot
+ * @param[in]  *safe pointer to a safe structure
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *status2 pointer to a status2 buffer
+ * @param[out] *time_us pointer to a snapshot time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or buffer is NULL
+ * @note       lock-free, it retries while the writer is publishing and never
+ *             touches the spi bus
+ */
+uint8_t isd17xx_safe_read_status(isd17xx_safe_t *safe, uint16_t *status1, uint8_t *status2, uint64_t *time_us)
+{
+    uint32_t seq;
+    
+    if ((safe == NULL) || (status1 == NULL) ||
+        (status2 == NULL) || (time_us == NULL))              /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    do
+    {
+        seq = safe->seq;                                     /* read the sequence */
+        ISD17XX_SAFE_BARRIER();                              /* order the sequence before the data */
+        *status1 = safe->status1;                            /* get status1 */
+        *status2 = safe->status2;                            /* get status2 */
+        *time_us = safe->time_us;                            /* get the time */
+        ISD17XX_SAFE_BARRIER();                              /* order the data before the check */
+    } while (((seq & 1) != 0) || (seq != safe->seq));        /* retry while writing or changed */
+    
+    return 0;                                                /* success return 0 */
+}
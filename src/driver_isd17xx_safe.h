@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_safe.h
+ * @brief     driver isd17xx safe header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_SAFE_H
+#define DRIVER_ISD17XX_SAFE_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_safe_driver isd17xx safe driver function
+ * @brief    isd17xx safe driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx safe memory barrier definition
+ * @note  define it for compilers without the gcc builtins
+ */
+#ifndef ISD17XX_SAFE_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define ISD17XX_SAFE_BARRIER()        __sync_synchronize()
+    #else
+        #define ISD17XX_SAFE_BARRIER()
+    #endif
+#endif
+
+/**
+ * @brief isd17xx safe structure definition
+ */
+typedef struct isd17xx_safe_s
+{
+    isd17xx_handle_t *handle;               /**< isd17xx handle */
+    void (*lock)(void *arg);                /**< point to a lock function address */
+    void (*unlock)(void *arg);              /**< point to an unlock function address */
+    void *arg;                              /**< lock argument */
+    volatile uint32_t seq;                  /**< snapshot sequence, odd while writing */
+    volatile uint16_t status1;              /**< snapshot status1 */
+    volatile uint8_t status2;               /**< snapshot status2 */
+    volatile uint64_t time_us;              /**< snapshot time in us */
+    uint32_t frame_count;                   /**< handle frame count at the outer lock */
+    uint32_t depth;                         /**< lock depth */
+} isd17xx_safe_t;
+
+/**
+ * @brief     initialize the safe layer
+ * @param[in] *safe pointer to a safe structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] *lock pointer to a lock function address
+ * @param[in] *unlock pointer to an unlock function address
+ * @param[in] *arg pointer to a lock argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 lock or unlock is NULL
+ * @note      the lock must be recursive when locked sequences call other
+ *            locked functions of this module, e.g. a pthread recursive mutex
+ */
+uint8_t isd17xx_safe_init(isd17xx_safe_t *safe, isd17xx_handle_t *handle,
+                          void (*lock)(void *arg), void (*unlock)(void *arg), void *arg);
+
+/**
+ * @brief     lock the handle
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      hold it around every multi-frame operation, e.g. the apc read
+ *            modify write of isd17xx_set_volume
+ */
+uint8_t isd17xx_safe_lock(isd17xx_safe_t *safe);
+
+/**
+ * @brief     unlock the handle
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      when the outer lock sent spi frames the status is read and published
+ *            before the lock is released, so the snapshot always shows the effect
+ *            of the last command, an idle lock sends nothing
+ */
+uint8_t isd17xx_safe_unlock(isd17xx_safe_t *safe);
+
+/**
+ * @brief     read the status and publish the snapshot
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 refresh failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the caller may already hold the lock
+ */
+uint8_t isd17xx_safe_refresh(isd17xx_safe_t *safe);
+
+/**
+ * @brief     run the irq handler and publish the snapshot
+ * @param[in] *safe pointer to a safe structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t isd17xx_safe_irq_handler(isd17xx_safe_t *safe);
+
+/**
+ * @brief      read the status snapshot
+ * @param[in]  *safe pointer to a safe structure
+ * @param[out] *status1 pointer to a status1 buffer
+ * @param[out] *status2 pointer to a status2 buffer
+ * @param[out] *time_us pointer to a snapshot time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or buffer is NULL
+ * @note       lock-free, it retries while the writer is publishing and never
+ *             touches the spi bus
+ */
+uint8_t isd17xx_safe_read_status(isd17xx_safe_t *safe, uint16_t *status1, uint8_t *status2, uint64_t *time_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_sync.c
+ * @brief     driver isd17xx sync source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_sync.h"
+
+/**
+ * @brief     clear all staged commands
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_sync_clear(isd17xx_sync_t *sync)
+{
+    if (sync == NULL)                               /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    memset(sync, 0, sizeof(isd17xx_sync_t));        /* clear the sync */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief     stage a set play command on a device
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 stage failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 device is busy
+ *            - 6 sync is full
+ *            - 7 get_time_us is NULL
+ * @note      the frame is encoded now, so the trigger only has to send it
+ */
+uint8_t isd17xx_sync_stage(isd17xx_sync_t *sync, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr)
+{
+    uint8_t status2;
+    uint16_t status1;
+    uint8_t buf[6];
+    
+    if ((sync == NULL) || (handle == NULL))                                                             /* check handle */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                                            /* check handle initialization */
+    {
+        return 3;                                                                                       /* return error */
+    }
+    if ((start_addr >= end_addr) || (end_addr > handle->end_address))                                   /* check the address */
+    {
+        handle->debug_print("isd17xx: address is invalid.\n");                                          /* address is invalid */
+        
+        return 4;                                                                                       /* return error */
+    }
+    if (handle->get_time_us == NULL)                                                                    /* check get_time_us */
+    {
+        handle->debug_print("isd17xx: get_time_us is null.\n");                                         /* get_time_us is null */
+        
+        return 7;                                                                                       /* return error */
+    }
+    if (sync->num >= ISD17XX_SYNC_MAX_DEVICE)                                                           /* check the num */
+    {
+        handle->debug_print("isd17xx: sync is full.\n");                                                /* sync is full */
+        
+        return 6;                                                                                       /* return error */
+    }
+    if (isd17xx_get_status(handle, &status1, &status2) != 0)                                            /* get the status */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    if (((status2 & ISD17XX_STATUS2_RDY) == 0) ||
+        ((status2 & (ISD17XX_STATUS2_PLAY | ISD17XX_STATUS2_REC | ISD17XX_STATUS2_ERASE)) != 0))        /* check the busy */
+    {
+        handle->debug_print("isd17xx: device is busy.\n");                                              /* device is busy */
+        
+        return 5;                                                                                       /* return error */
+    }
+    
+    buf[0] = 0x00;                                                                                      /* set 0x00 */
+    buf[1] = start_addr & 0xFF;                                                                         /* set start address */
+    buf[2] = (start_addr >> 8) & 0x07;                                                                  /* set start address */
+    buf[3] = end_addr & 0xFF;                                                                           /* set end address */
+    buf[4] = (end_addr >> 8) & 0x07;                                                                    /* set end address */
+    buf[5] = 0x00;                                                                                      /* set 0x00 */
+    (void)isd17xx_frame_encode(ISD17XX_COMMAND_SET_PLAY, buf, 6, sync->tx[sync->num]);                  /* encode the frame */
+    sync->handle[sync->num] = handle;                                                                   /* set the handle */
+    sync->num++;                                                                                        /* num++ */
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      start all staged devices
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *skew_us pointer to a start skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger failed
+ *             - 2 handle is NULL
+ *             - 4 nothing is staged
+ * @note       the frames are sent back to back through isd17xx_frame_transmit without any delay,
+ *             the skew is the time between the first and the last frame, the stage is kept
+ *             so the same start can be triggered again, the cached status and the message index
+ *             of every staged device are dropped
+ */
+uint8_t isd17xx_sync_trigger(isd17xx_sync_t *sync, uint32_t *skew_us)
+{
+    uint8_t i;
+    uint8_t res;
+    uint64_t t[ISD17XX_SYNC_MAX_DEVICE];
+    isd17xx_spi_segment_t seg;
+    
+    if (sync == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (sync->num == 0)                                                            /* check the num */
+    {
+        return 4;                                                                  /* return error */
+    }
+    
+    res = 0;                                                                       /* init 0 */
+    for (i = 0; i < sync->num; i++)                                                /* fire in one tight loop */
+    {
+        seg.tx = sync->tx[i];                                                      /* set the tx */
+        seg.rx = sync->rx[i];                                                      /* set the rx */
+        seg.len = 7;                                                               /* set 7 */
+        if (isd17xx_frame_transmit(sync->handle[i], &seg, 1) != 0)                 /* send the staged frame */
+        {
+            res = 1;                                                               /* set failed */
+        }
+        t[i] = sync->handle[i]->get_time_us();                                     /* get the start time */
+    }
+    for (i = 0; i < sync->num; i++)                                                /* get the offsets */
+    {
+        sync->offset_us[i] = (uint32_t)(t[i] - t[0]);                              /* set the offset */
+        sync->handle[i]->message_index_valid = 0;                                  /* drop the message index */
+    }
+    sync->skew_us = sync->offset_us[sync->num - 1];                                /* set the skew */
+    *skew_us = sync->skew_us;                                                      /* get the skew */
+    if (res != 0)                                                                  /* check the result */
+    {
+        sync->handle[0]->debug_print("isd17xx: trigger failed.\n");                /* trigger failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_sync.h
+ * @brief     driver isd17xx sync header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_SYNC_H
+#define DRIVER_ISD17XX_SYNC_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_sync_driver isd17xx sync driver function
+ * @brief    isd17xx sync driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx sync max definition
+ */
+#ifndef ISD17XX_SYNC_MAX_DEVICE
+    #define ISD17XX_SYNC_MAX_DEVICE        8        /**< max staged device number */
+#endif
+
+/**
+ * @brief isd17xx sync structure definition
+ */
+typedef struct isd17xx_sync_s
+{
+    isd17xx_handle_t *handle[ISD17XX_SYNC_MAX_DEVICE];        /**< staged handles */
+    uint8_t tx[ISD17XX_SYNC_MAX_DEVICE][7];                   /**< staged encoded frame */
+    uint8_t rx[ISD17XX_SYNC_MAX_DEVICE][7];                   /**< response frame */
+    uint8_t num;                                              /**< staged device number */
+    uint32_t offset_us[ISD17XX_SYNC_MAX_DEVICE];              /**< start offset from the first device in us */
+    uint32_t skew_us;                                         /**< last start skew in us */
+} isd17xx_sync_t;
+
+/**
+ * @brief     clear all staged commands
+ * @param[in] *sync pointer to a sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t isd17xx_sync_clear(isd17xx_sync_t *sync);
+
+/**
+ * @brief     stage a set play command on a device
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] *handle pointer to an isd17xx handle structure
+ * @param[in] start_addr start address
+ * @param[in] end_addr end address
+ * @return    status code
+ *            - 0 success
+ *            - 1 stage failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address is invalid
+ *            - 5 device is busy
+ *            - 6 sync is full
+ *            - 7 get_time_us is NULL
+ * @note      the frame is encoded now, so the trigger only has to send it
+ */
+uint8_t isd17xx_sync_stage(isd17xx_sync_t *sync, isd17xx_handle_t *handle, uint16_t start_addr, uint16_t end_addr);
+
+/**
+ * @brief      start all staged devices
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *skew_us pointer to a start skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger failed
+ *             - 2 handle is NULL
+ *             - 4 nothing is staged
+ * @note       the frames are sent back to back through isd17xx_frame_transmit without any delay,
+ *             the skew is the time between the first and the last frame, the stage is kept
+ *             so the same start can be triggered again, the cached status and the message index
+ *             of every staged device are dropped
+ */
+uint8_t isd17xx_sync_trigger(isd17xx_sync_t *sync, uint32_t *skew_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,482 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_volume.c
+ * @brief     driver isd17xx volume source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_isd17xx_volume.h"
+
+/**
+ * @brief     get the device of a logical address
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] addr logical address
+ * @return    device index
+ * @note      addr must be less than the volume size
+ */
+static uint8_t a_isd17xx_volume_device(isd17xx_volume_t *volume, uint32_t addr)
+{
+    uint8_t i;
+    
+    for (i = volume->device_num - 1; i > 0; i--)        /* search from the last device */
+    {
+        if (addr >= volume->base[i])                    /* check the base */
+        {
+            break;                                      /* found */
+        }
+    }
+    
+    return i;                                           /* return the device */
+}
+
+/**
+ * @brief     get the logical end address of a device
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] device device index
+ * @return    logical end address
+ * @note      none
+ */
+static uint32_t a_isd17xx_volume_device_end(isd17xx_volume_t *volume, uint8_t device)
+{
+    if (device + 1 < volume->device_num)            /* check the last device */
+    {
+        return volume->base[device + 1] - 1;        /* before the next base */
+    }
+    
+    return volume->size - 1;                        /* volume end */
+}
+
+/**
+ * @brief     check whether a logical range can be placed
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] addr logical start address
+ * @param[in] rows row number
+ * @return    1 if it fits, otherwise 0
+ * @note      the range must be free and must not leave a single row on a device
+ */
+static uint8_t a_isd17xx_volume_fits(isd17xx_volume_t *volume, uint32_t addr, uint32_t rows)
+{
+    uint8_t i;
+    uint32_t end;
+    uint32_t piece_start;
+    uint32_t piece_end;
+    
+    if ((addr >= volume->size) || (rows > volume->size - addr))                                 /* check the volume */
+    {
+        return 0;                                                                               /* out of the volume */
+    }
+    end = addr + rows - 1;                                                                      /* get the end */
+    for (i = 0; i < ISD17XX_VOLUME_MAX_ENTRY; i++)                                              /* check all entries */
+    {
+        if ((volume->entry[i].used != 0) &&
+            (volume->entry[i].start_addr <= end) && (volume->entry[i].end_addr >= addr))        /* check the overlap */
+        {
+            return 0;                                                                           /* used */
+        }
+    }
+    for (i = a_isd17xx_volume_device(volume, addr); i < volume->device_num; i++)                /* check every piece */
+    {
+        if (volume->base[i] > end)                                                              /* check the end */
+        {
+            break;                                                                              /* done */
+        }
+        piece_start = (addr > volume->base[i]) ? addr : volume->base[i];                        /* get the piece start */
+        piece_end = a_isd17xx_volume_device_end(volume, i);                                     /* get the device end */
+        piece_end = (end < piece_end) ? end : piece_end;                                        /* get the piece end */
+        if (piece_start == piece_end)                                                           /* set play needs two rows */
+        {
+            return 0;                                                                           /* single row */
+        }
+    }
+    
+    return 1;                                                                                   /* fits */
+}
+
+/**
+ * @brief     start the next device piece
+ * @param[in] *volume pointer to a volume structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      a stale interrupt is cleared first so it can not end the new piece,
+ *            the end of the piece is reported by int and collected by isd17xx_volume_poll
+ */
+static uint8_t a_isd17xx_volume_start(isd17xx_volume_t *volume)
+{
+    uint8_t res;
+    uint8_t device;
+    uint16_t status1;
+    uint16_t command_delay;
+    uint32_t end;
+    isd17xx_handle_t *handle;
+    
+    device = a_isd17xx_volume_device(volume, volume->play_addr);                                      /* get the device */
+    handle = volume->handle[device];                                                                  /* get the handle */
+    end = a_isd17xx_volume_device_end(volume, device);                                                /* get the device end */
+    end = (volume->play_end < end) ? volume->play_end : end;                                          /* get the piece end */
+    res = isd17xx_irq_service(handle, ISD17XX_IRQ_CAPTURE_NONE, &status1, NULL);                      /* clear a stale interrupt */
+    if (res == 0)                                                                                     /* check the result */
+    {
+        command_delay = handle->command_delay;                                                        /* save the command delay */
+        handle->command_delay = 0;                                                                    /* int reports the end */
+        res = isd17xx_set_play(handle, (uint16_t)(volume->play_addr - volume->base[device] + ISD17XX_VOLUME_FIRST_ROW),
+                               (uint16_t)(end - volume->base[device] + ISD17XX_VOLUME_FIRST_ROW));    /* set play */
+        handle->command_delay = command_delay;                                                        /* restore the command delay */
+    }
+    if (res != 0)                                                                                     /* check the result */
+    {
+        volume->playing = 0;                                                                          /* stop playing */
+        
+        return 1;                                                                                     /* return error */
+    }
+    volume->play_device = device;                                                                     /* set the playing device */
+    volume->play_addr = end + 1;                                                                      /* next piece */
+    volume->playing = 1;                                                                              /* set playing */
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     initialize the volume
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] **handle pointer to a handle pointer array
+ * @param[in] num device number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 num is invalid
+ * @note      the devices are concatenated in the array order
+ */
+uint8_t isd17xx_volume_init(isd17xx_volume_t *volume, isd17xx_handle_t **handle, uint8_t num)
+{
+    uint8_t i;
+    
+    if ((volume == NULL) || (handle == NULL))                                                   /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if ((num == 0) || (num > ISD17XX_VOLUME_MAX_DEVICE))                                        /* check the num */
+    {
+        return 4;                                                                               /* return error */
+    }
+    for (i = 0; i < num; i++)                                                                   /* check all handles */
+    {
+        if (handle[i] == NULL)                                                                  /* check handle */
+        {
+            return 2;                                                                           /* return error */
+        }
+        if (handle[i]->inited != 1)                                                             /* check handle initialization */
+        {
+            return 3;                                                                           /* return error */
+        }
+        if (handle[i]->end_address <= ISD17XX_VOLUME_FIRST_ROW)                                 /* check the type */
+        {
+            handle[i]->debug_print("isd17xx: num is invalid.\n");                               /* num is invalid */
+            
+            return 4;                                                                           /* return error */
+        }
+    }
+    
+    memset(volume, 0, sizeof(isd17xx_volume_t));                                                /* clear the volume */
+    for (i = 0; i < num; i++)                                                                   /* concatenate the devices */
+    {
+        volume->handle[i] = handle[i];                                                          /* set the handle */
+        volume->base[i] = volume->size;                                                         /* set the base */
+        volume->size += (uint32_t)handle[i]->end_address - ISD17XX_VOLUME_FIRST_ROW + 1;        /* add the rows */
+    }
+    volume->device_num = num;                                                                   /* set the device number */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      allocate logical rows
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  rows row number
+ * @param[out] *id pointer to an entry id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 rows is less than 2
+ *             - 5 volume catalog is full
+ *             - 6 no free range is large enough
+ * @note       an entry may cross devices, but never leaves a single row on one
+ */
+uint8_t isd17xx_volume_alloc(isd17xx_volume_t *volume, uint32_t rows, uint8_t *id)
+{
+    uint8_t i;
+    uint8_t k;
+    uint8_t slot;
+    uint32_t addr;
+    uint32_t best;
+    
+    if ((volume == NULL) || (volume->device_num == 0))                                      /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (rows < 2)                                                                           /* check the rows */
+    {
+        volume->handle[0]->debug_print("isd17xx: rows is less than 2.\n");                  /* rows is less than 2 */
+        
+        return 4;                                                                           /* return error */
+    }
+    
+    slot = ISD17XX_VOLUME_MAX_ENTRY;                                                        /* init invalid */
+    for (i = 0; i < ISD17XX_VOLUME_MAX_ENTRY; i++)                                          /* find a free entry */
+    {
+        if (volume->entry[i].used == 0)                                                     /* check the used flag */
+        {
+            slot = i;                                                                       /* set the slot */
+            
+            break;                                                                          /* break */
+        }
+    }
+    if (slot == ISD17XX_VOLUME_MAX_ENTRY)                                                   /* check the slot */
+    {
+        volume->handle[0]->debug_print("isd17xx: volume catalog is full.\n");               /* volume catalog is full */
+        
+        return 5;                                                                           /* return error */
+    }
+    
+    best = 0xFFFFFFFFU;                                                                     /* init invalid */
+    for (k = 0; k < 2; k++)                                                                 /* the volume start, or one row later to avoid a single row piece */
+    {
+        if ((k < best) && (a_isd17xx_volume_fits(volume, k, rows) != 0))                    /* check the fit */
+        {
+            best = k;                                                                       /* set the best */
+        }
+    }
+    for (i = 0; i < ISD17XX_VOLUME_MAX_ENTRY; i++)                                          /* after every entry */
+    {
+        if (volume->entry[i].used == 0)                                                     /* check the used flag */
+        {
+            continue;                                                                       /* skip */
+        }
+        for (k = 1; k < 3; k++)                                                             /* right after, or one row later */
+        {
+            addr = volume->entry[i].end_addr + k;                                           /* get the address */
+            if ((addr < best) && (a_isd17xx_volume_fits(volume, addr, rows) != 0))          /* check the fit */
+            {
+                best = addr;                                                                /* set the best */
+            }
+        }
+    }
+    if (best == 0xFFFFFFFFU)                                                                /* check the best */
+    {
+        volume->handle[0]->debug_print("isd17xx: no free range is large enough.\n");        /* no free range is large enough */
+        
+        return 6;                                                                           /* return error */
+    }
+    volume->entry[slot].start_addr = best;                                                  /* set the start address */
+    volume->entry[slot].end_addr = best + rows - 1;                                         /* set the end address */
+    volume->entry[slot].used = 1;                                                           /* set used */
+    *id = slot;                                                                             /* set the id */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     free an entry
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_volume_free(isd17xx_volume_t *volume, uint8_t id)
+{
+    if ((volume == NULL) || (volume->device_num == 0))                            /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if ((id >= ISD17XX_VOLUME_MAX_ENTRY) || (volume->entry[id].used == 0))        /* check the id */
+    {
+        volume->handle[0]->debug_print("isd17xx: id is invalid.\n");              /* id is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    volume->entry[id].used = 0;                                                   /* clear used */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get an entry
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  id entry id
+ * @param[out] *start_addr pointer to a logical start address buffer
+ * @param[out] *end_addr pointer to a logical end address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 id is invalid
+ * @note       none
+ */
+uint8_t isd17xx_volume_get_entry(isd17xx_volume_t *volume, uint8_t id, uint32_t *start_addr, uint32_t *end_addr)
+{
+    if ((volume == NULL) || (volume->device_num == 0))                            /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if ((id >= ISD17XX_VOLUME_MAX_ENTRY) || (volume->entry[id].used == 0))        /* check the id */
+    {
+        volume->handle[0]->debug_print("isd17xx: id is invalid.\n");              /* id is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    *start_addr = volume->entry[id].start_addr;                                   /* get the start address */
+    *end_addr = volume->entry[id].end_addr;                                       /* get the end address */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      map a logical address to a device row
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  addr logical address
+ * @param[out] *device pointer to a device index buffer
+ * @param[out] *row pointer to a row address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 addr is invalid
+ * @note       none
+ */
+uint8_t isd17xx_volume_map(isd17xx_volume_t *volume, uint32_t addr, uint8_t *device, uint16_t *row)
+{
+    if ((volume == NULL) || (volume->device_num == 0))                                 /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (addr >= volume->size)                                                          /* check the address */
+    {
+        volume->handle[0]->debug_print("isd17xx: addr is invalid.\n");                 /* addr is invalid */
+        
+        return 4;                                                                      /* return error */
+    }
+    
+    *device = a_isd17xx_volume_device(volume, addr);                                   /* get the device */
+    *row = (uint16_t)(addr - volume->base[*device] + ISD17XX_VOLUME_FIRST_ROW);        /* get the row */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     start playing an entry
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      the part on the first device starts at once, call
+ *            isd17xx_volume_poll to hand the rest over to the next devices
+ */
+uint8_t isd17xx_volume_play(isd17xx_volume_t *volume, uint8_t id)
+{
+    if ((volume == NULL) || (volume->device_num == 0))                            /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if ((id >= ISD17XX_VOLUME_MAX_ENTRY) || (volume->entry[id].used == 0))        /* check the id */
+    {
+        volume->handle[0]->debug_print("isd17xx: id is invalid.\n");              /* id is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    volume->play_addr = volume->entry[id].start_addr;                             /* set the play address */
+    volume->play_end = volume->entry[id].end_addr;                                /* set the play end */
+    
+    return a_isd17xx_volume_start(volume);                                        /* start the first piece */
+}
+
+/**
+ * @brief      poll the playback
+ * @param[in]  *volume pointer to a volume structure
+ * @param[out] *playing pointer to a playing flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 handle is NULL
+ * @note       one clear interrupt frame per call, when the playing device raises
+ *             eom or int the next device is started, call it from the int line
+ *             of the playing device or from a periodic timer
+ */
+uint8_t isd17xx_volume_poll(isd17xx_volume_t *volume, uint8_t *playing)
+{
+    uint16_t status1;
+    
+    if ((volume == NULL) || (volume->device_num == 0))                                                /* check handle */
+    {
+        return 2;                                                                                     /* return error */
+    }
+    
+    if (volume->playing != 0)                                                                         /* check the playing */
+    {
+        if (isd17xx_irq_service(volume->handle[volume->play_device], ISD17XX_IRQ_CAPTURE_NONE,
+                                &status1, NULL) != 0)                                                 /* read status1 and clear int */
+        {
+            return 1;                                                                                 /* return error */
+        }
+        if ((status1 & ISD17XX_STATUS1_CMD_ERR) != 0)                                                 /* check the command error */
+        {
+            volume->playing = 0;                                                                      /* stop playing */
+            
+            return 1;                                                                                 /* return error */
+        }
+        if ((status1 & (ISD17XX_STATUS1_EOM | ISD17XX_STATUS1_INT)) != 0)                             /* the device reached its end */
+        {
+            if (volume->play_addr > volume->play_end)                                                 /* check the end */
+            {
+                volume->playing = 0;                                                                  /* finished */
+            }
+            else
+            {
+                if (a_isd17xx_volume_start(volume) != 0)                                              /* hand over to the next device */
+                {
+                    return 1;                                                                         /* return error */
+                }
+                volume->handoff_count++;                                                              /* handoff count++ */
+            }
+        }
+    }
+    *playing = volume->playing;                                                                       /* get the playing */
+    
+    return 0;                                                                                         /* success return 0 */
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_isd17xx_volume.h
+ * @brief     driver isd17xx volume header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_ISD17XX_VOLUME_H
+#define DRIVER_ISD17XX_VOLUME_H
+
+#include "driver_isd17xx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup isd17xx_volume_driver isd17xx volume driver function
+ * @brief    isd17xx volume driver modules
+ * @ingroup  isd17xx_driver
+ * @{
+ */
+
+/**
+ * @brief isd17xx volume max definition
+ */
+#ifndef ISD17XX_VOLUME_MAX_DEVICE
+    #define ISD17XX_VOLUME_MAX_DEVICE        8          /**< max device number */
+#endif
+#ifndef ISD17XX_VOLUME_MAX_ENTRY
+    #define ISD17XX_VOLUME_MAX_ENTRY         64         /**< max entry number */
+#endif
+#ifndef ISD17XX_VOLUME_FIRST_ROW
+    #define ISD17XX_VOLUME_FIRST_ROW         0x010      /**< first message row of every device */
+#endif
+
+/**
+ * @brief isd17xx volume entry structure definition
+ */
+typedef struct isd17xx_volume_entry_s
+{
+    uint32_t start_addr;       /**< logical start address */
+    uint32_t end_addr;         /**< logical end address */
+    uint8_t used;              /**< used flag */
+} isd17xx_volume_entry_t;
+
+/**
+ * @brief isd17xx volume structure definition
+ */
+typedef struct isd17xx_volume_s
+{
+    isd17xx_handle_t *handle[ISD17XX_VOLUME_MAX_DEVICE];        /**< device handles */
+    uint32_t base[ISD17XX_VOLUME_MAX_DEVICE];                   /**< logical start address of every device */
+    uint8_t device_num;                                         /**< device number */
+    uint32_t size;                                              /**< logical rows */
+    isd17xx_volume_entry_t entry[ISD17XX_VOLUME_MAX_ENTRY];     /**< entries */
+    uint32_t play_addr;                                         /**< next logical address to play */
+    uint32_t play_end;                                          /**< logical end address to play */
+    uint8_t play_device;                                        /**< playing device */
+    uint8_t playing;                                            /**< playing flag */
+    uint32_t handoff_count;                                     /**< device handoff count */
+} isd17xx_volume_t;
+
+/**
+ * @brief     initialize the volume
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] **handle pointer to a handle pointer array
+ * @param[in] num device number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 num is invalid
+ * @note      the devices are concatenated in the array order
+ */
+uint8_t isd17xx_volume_init(isd17xx_volume_t *volume, isd17xx_handle_t **handle, uint8_t num);
+
+/**
+ * @brief      allocate logical rows
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  rows row number
+ * @param[out] *id pointer to an entry id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 rows is less than 2
+ *             - 5 volume catalog is full
+ *             - 6 no free range is large enough
+ * @note       an entry may cross devices, but never leaves a single row on one
+ */
+uint8_t isd17xx_volume_alloc(isd17xx_volume_t *volume, uint32_t rows, uint8_t *id);
+
+/**
+ * @brief     free an entry
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t isd17xx_volume_free(isd17xx_volume_t *volume, uint8_t id);
+
+/**
+ * @brief      get an entry
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  id entry id
+ * @param[out] *start_addr pointer to a logical start address buffer
+ * @param[out] *end_addr pointer to a logical end address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 id is invalid
+ * @note       none
+ */
+uint8_t isd17xx_volume_get_entry(isd17xx_volume_t *volume, uint8_t id, uint32_t *start_addr, uint32_t *end_addr);
+
+/**
+ * @brief      map a logical address to a device row
+ * @param[in]  *volume pointer to a volume structure
+ * @param[in]  addr logical address
+ * @param[out] *device pointer to a device index buffer
+ * @param[out] *row pointer to a row address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 addr is invalid
+ * @note       none
+ */
+uint8_t isd17xx_volume_map(isd17xx_volume_t *volume, uint32_t addr, uint8_t *device, uint16_t *row);
+
+/**
+ * @brief     start playing an entry
+ * @param[in] *volume pointer to a volume structure
+ * @param[in] id entry id
+ * @return    status code
+ *            - 0 success
+ *            - 1 play failed
+ *            - 2 handle is NULL
+ *            - 4 id is invalid
+ * @note      the part on the first device starts at once, call
+ *            isd17xx_volume_poll to hand the rest over to the next devices
+ */
+uint8_t isd17xx_volume_play(isd17xx_volume_t *volume, uint8_t id);
+
+/**
+ * @brief      poll the playback
+ * @param[in]  *volume pointer to a volume structure
+ * @param[out] *playing pointer to a playing flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ *             - 2 handle is NULL
+ * @note       one clear interrupt frame per call, when the playing device raises
+ *             eom or int the next device is started, call it from the int line
+ *             of the playing device or from a periodic timer
+ */
+uint8_t isd17xx_volume_poll(isd17xx_volume_t *volume, uint8_t *playing);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -53,9 +53,25 @@ uint8_t isd17xx_register_test(isd17xx_type_t type)
     uint8_t id;
     uint8_t vol;
     uint8_t vol_check;
+    uint8_t value;
+    uint8_t value_check;
+    uint8_t num;
     uint8_t status2;
     uint16_t status1;
     uint16_t point;
+    uint16_t config;
+    uint16_t config_check;
+    uint16_t ms;
+    uint16_t ms_check;
+    uint16_t ms_saved;
+    uint32_t us;
+    uint32_t us_check;
+    uint32_t hit;
+    uint32_t miss;
+    uint32_t count;
+    uint32_t mean_us;
+    uint32_t max_us;
+    uint64_t clock_us;
     isd17xx_bool_t enable;
     isd17xx_info_t info;
     isd17xx_type_t type_check;
@@ -70,6 +86,8 @@ uint8_t isd17xx_register_test(isd17xx_type_t type)
     DRIVER_ISD17XX_LINK_SPI_WRITE(&gs_handle, isd17xx_interface_spi_write);
     DRIVER_ISD17XX_LINK_SPI_TRANSMIT(&gs_handle, isd17xx_interface_spi_transmit);
     DRIVER_ISD17XX_LINK_DELAY_MS(&gs_handle, isd17xx_interface_delay_ms);
+    DRIVER_ISD17XX_LINK_DELAY_US(&gs_handle, isd17xx_interface_delay_us);
+    DRIVER_ISD17XX_LINK_GET_TIME_US(&gs_handle, isd17xx_interface_get_time_us);
     DRIVER_ISD17XX_LINK_DEBUG_PRINT(&gs_handle, isd17xx_interface_debug_print);
     DRIVER_ISD17XX_LINK_GPIO_RESET_INIT(&gs_handle, isd17xx_interface_gpio_reset_init);
     DRIVER_ISD17XX_LINK_GPIO_RESET_DEINIT(&gs_handle, isd17xx_interface_gpio_reset_deinit);
@@ -887,6 +905,282 @@ uint8_t isd17xx_register_test(isd17xx_type_t type)
     }
     isd17xx_interface_debug_print("isd17xx: check eom %s.\n", (enable == ISD17XX_BOOL_FALSE) ? "ok" : "error");
     
+    /* set eom invalid */
+    res = isd17xx_set_eom(&gs_handle, (isd17xx_bool_t)2);
+    isd17xx_interface_debug_print("isd17xx: check eom invalid %s.\n", (res == 5) ? "ok" : "error");
+    
+    /* isd17xx_apc_set_field/isd17xx_apc_get_field test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_apc_set_field/isd17xx_apc_get_field test.\n");
+    
+    /* set volume field */
+    value = rand() % 8;
+    res = isd17xx_apc_set_field(&gs_handle, ISD17XX_APC_FIELD_VOLUME, value);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc set field failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: set volume field 0x%0x.\n", value);
+    
+    /* get volume field */
+    res = isd17xx_apc_get_field(&gs_handle, ISD17XX_APC_FIELD_VOLUME, &value_check);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc get field failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check volume field %s.\n", (value == value_check) ? "ok" : "error");
+    
+    /* set pwm speaker field, active low */
+    value = rand() % 2;
+    res = isd17xx_apc_set_field(&gs_handle, ISD17XX_APC_FIELD_PWM_SPEAKER, value);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc set field failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: set pwm speaker field 0x%0x.\n", value);
+    
+    /* get pwm speaker field */
+    res = isd17xx_apc_get_field(&gs_handle, ISD17XX_APC_FIELD_PWM_SPEAKER, &value_check);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc get field failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check pwm speaker field %s.\n", (value == value_check) ? "ok" : "error");
+    
+    /* set invalid field and value */
+    res = isd17xx_apc_set_field(&gs_handle, ISD17XX_APC_FIELD_NUM, 0);
+    isd17xx_interface_debug_print("isd17xx: check field invalid %s.\n", (res == 4) ? "ok" : "error");
+    res = isd17xx_apc_set_field(&gs_handle, ISD17XX_APC_FIELD_EOM, 2);
+    isd17xx_interface_debug_print("isd17xx: check value invalid %s.\n", (res == 5) ? "ok" : "error");
+    
+    /* isd17xx_apc_read/isd17xx_apc_write test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_apc_read/isd17xx_apc_write test.\n");
+    
+    /* read apc */
+    res = isd17xx_apc_read(&gs_handle, &config);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc read failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* change the volume only */
+    value = rand() % 8;
+    (void)isd17xx_apc_encode_field(&config, ISD17XX_APC_FIELD_VOLUME, value);
+    res = isd17xx_apc_write(&gs_handle, config);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc write failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: write apc 0x%03X.\n", config);
+    
+    /* read apc */
+    res = isd17xx_apc_read(&gs_handle, &config_check);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: apc read failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)isd17xx_apc_decode_field(config_check, ISD17XX_APC_FIELD_VOLUME, &value_check);
+    isd17xx_interface_debug_print("isd17xx: check apc %s.\n", ((config == config_check) && (value == value_check)) ? "ok" : "error");
+    
+    /* isd17xx_set_command_delay/isd17xx_get_command_delay test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_set_command_delay/isd17xx_get_command_delay test.\n");
+    
+    /* save the command delay */
+    res = isd17xx_get_command_delay(&gs_handle, &ms_saved);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get command delay failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set command delay */
+    ms = rand() % 1000;
+    res = isd17xx_set_command_delay(&gs_handle, ms);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: set command delay failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: set command delay %dms.\n", ms);
+    
+    /* get command delay */
+    res = isd17xx_get_command_delay(&gs_handle, &ms_check);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get command delay failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check command delay %s.\n", (ms == ms_check) ? "ok" : "error");
+    
+    /* restore the command delay */
+    res = isd17xx_set_command_delay(&gs_handle, ms_saved);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: set command delay failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* isd17xx_set_status_max_age/isd17xx_get_status_max_age test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_set_status_max_age/isd17xx_get_status_max_age test.\n");
+    
+    /* set status max age */
+    us = 100000 + rand() % 100000;
+    res = isd17xx_set_status_max_age(&gs_handle, us);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: set status max age failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: set status max age %dus.\n", us);
+    
+    /* get status max age */
+    res = isd17xx_get_status_max_age(&gs_handle, &us_check);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get status max age failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check status max age %s.\n", (us == us_check) ? "ok" : "error");
+    
+    /* isd17xx_get_status_cache_statistics test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_get_status_cache_statistics test.\n");
+    
+    /* the first read misses and the second one hits */
+    res = isd17xx_get_status(&gs_handle, &status1, &status2);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get status failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = isd17xx_get_status(&gs_handle, &status1, &status2);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get status failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get status cache statistics */
+    res = isd17xx_get_status_cache_statistics(&gs_handle, &hit, &miss);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get status cache statistics failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: status cache hit %d miss %d.\n", hit, miss);
+    isd17xx_interface_debug_print("isd17xx: check status cache statistics %s.\n", ((hit == 1) && (miss == 1)) ? "ok" : "error");
+    
+    /* disable the status cache */
+    res = isd17xx_set_status_max_age(&gs_handle, 0);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: set status max age failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* isd17xx_get_delay_statistics/isd17xx_clear_delay_statistics test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_get_delay_statistics/isd17xx_clear_delay_statistics test.\n");
+    
+    /* clear delay statistics */
+    res = isd17xx_clear_delay_statistics(&gs_handle);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: clear delay statistics failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get delay statistics */
+    res = isd17xx_get_delay_statistics(&gs_handle, &count, &mean_us, &max_us);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get delay statistics failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check clear delay statistics %s.\n", ((count == 0) && (max_us == 0)) ? "ok" : "error");
+    
+    /* delay 10ms */
+    res = isd17xx_get_clock(&gs_handle, &clock_us);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get clock failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = isd17xx_delay_until(&gs_handle, clock_us + 10000);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: delay until failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get delay statistics */
+    res = isd17xx_get_delay_statistics(&gs_handle, &count, &mean_us, &max_us);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get delay statistics failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: delay count %d mean overshoot %dus max overshoot %dus.\n", count, mean_us, max_us);
+    isd17xx_interface_debug_print("isd17xx: check delay statistics %s.\n", (count == 1) ? "ok" : "error");
+    
     /* isd17xx_load_from_nv test */
     isd17xx_interface_debug_print("isd17xx: isd17xx_load_from_nv test.\n");
     
@@ -947,6 +1241,33 @@ uint8_t isd17xx_register_test(isd17xx_type_t type)
     /* output */
     isd17xx_interface_debug_print("isd17xx: record point is 0x%04X.\n", point);
     
+    /* isd17xx_get_message_number test */
+    isd17xx_interface_debug_print("isd17xx: isd17xx_get_message_number test.\n");
+    
+    /* get message number */
+    res = isd17xx_get_message_number(&gs_handle, &num);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get message number failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    isd17xx_interface_debug_print("isd17xx: message number is %d.\n", num);
+    
+    /* get the cached message number */
+    res = isd17xx_get_message_number(&gs_handle, &value);
+    if (res != 0)
+    {
+        isd17xx_interface_debug_print("isd17xx: get message number failed.\n");
+        (void)isd17xx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    isd17xx_interface_debug_print("isd17xx: check message number %s.\n", (num == value) ? "ok" : "error");
+    
     /* isd17xx_get_status test */
     isd17xx_interface_debug_print("isd17xx: isd17xx_get_status test.\n");
     